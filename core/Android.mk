@@ -35,6 +35,7 @@ COMMON_FILES :=	\
 	src/Result.cpp \
 	src/ResultMetadata.cpp \
 	src/ResultPoint.cpp \
+	src/StructuredAppendAssembler.cpp \
 	src/TextDecoder.cpp \
 	src/TextUtfEncoding.cpp \
 	src/WhiteRectDetector.cpp \
@@ -56,6 +57,7 @@ DATAMATRIX_FILES :=	\
 MAXICODE_FILES := \
 	src/maxicode/MCBitMatrixParser.cpp \
 	src/maxicode/MCDecoder.cpp \
+	src/maxicode/MCDetector.cpp \
 	src/maxicode/MCReader.cpp
 	
 ONED_FILES := \
@@ -98,6 +100,7 @@ QRCODE_FILES := \
 	src/qrcode/QRErrorCorrectionLevel.cpp \
 	src/qrcode/QRFormatInformation.cpp \
 	src/qrcode/QRReader.cpp \
+	src/qrcode/QRSymbolCache.cpp \
 	src/qrcode/QRVersion.cpp
 
 TEXT_CODEC_FILES := \
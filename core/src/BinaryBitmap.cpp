@@ -16,7 +16,65 @@
 
 #include "BinaryBitmap.h"
 
+#include "BitMatrix.h"
+#include "ZXConfig.h"
+
+#include <mutex>
+
 namespace ZXing {
 
+struct BinaryBitmap::PatternCache
+{
+	std::once_flag once;
+	std::shared_ptr<const BitMatrix> matrix;
+	std::vector<PatternRow> rows, cols;
+	std::unique_ptr<std::once_flag[]> rowsOnce, colsOnce;
+};
+
+BinaryBitmap::BinaryBitmap() : _patternCache(new PatternCache) {}
+
+BinaryBitmap::~BinaryBitmap() = default;
+
+BinaryBitmap::PatternCache& BinaryBitmap::patternCache() const
+{
+	auto& cache = *_patternCache;
+	std::call_once(cache.once, [&] {
+		cache.matrix = getBlackMatrix();
+		if (cache.matrix) {
+			cache.rows.resize(cache.matrix->height());
+			cache.cols.resize(cache.matrix->width());
+			cache.rowsOnce.reset(new std::once_flag[cache.matrix->height()]);
+			cache.colsOnce.reset(new std::once_flag[cache.matrix->width()]);
+		}
+	});
+	return cache;
+}
+
+static const PatternRow EMPTY_PATTERN_ROW;
+
+const PatternRow& BinaryBitmap::getBlackPatternRow(int y) const
+{
+	auto& cache = patternCache();
+	if (!cache.matrix)
+		return EMPTY_PATTERN_ROW;
+
+	std::call_once(cache.rowsOnce[y], [&] {
+		// getPatternRow needs a buffer of the size of the whole row, the cache only keeps what is actually used
+		ZX_THREAD_LOCAL PatternRow buffer;
+		cache.matrix->getPatternRow(y, buffer);
+		cache.rows[y].assign(buffer.begin(), buffer.end());
+	});
+	return cache.rows[y];
+}
+
+const PatternRow& BinaryBitmap::getBlackPatternColumn(int x) const
+{
+	auto& cache = patternCache();
+	if (!cache.matrix)
+		return EMPTY_PATTERN_ROW;
+
+	std::call_once(cache.colsOnce[x], [&] { cache.matrix->getPatternColumn(x, cache.cols[x]); });
+	return cache.cols[x];
+}
 
 } // ZXing
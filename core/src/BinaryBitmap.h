@@ -36,8 +36,14 @@ using PatternRow = std::vector<uint16_t>;
 */
 class BinaryBitmap
 {
+	struct PatternCache;
+	std::unique_ptr<PatternCache> _patternCache;
+
+	PatternCache& patternCache() const;
+
 public:
-	virtual ~BinaryBitmap() = default;
+	BinaryBitmap();
+	virtual ~BinaryBitmap();
 
 	/**
 	* Image is a pure monochrome image of a barcode.
@@ -70,6 +76,20 @@ public:
 	*/
 	virtual std::shared_ptr<const BitMatrix> getBlackMatrix() const = 0;
 
+	/**
+	* Converts one row of the black matrix to a vector of ints denoting the widths of the bars and spaces (see
+	* BitMatrix::getPatternRow). Each row is computed on first use and kept for the lifetime of this bitmap, such that
+	* all readers looking at the same image share the work. Thread safe.
+	*
+	* @return the pattern row or an empty one if the image can't be binarized
+	*/
+	const PatternRow& getBlackPatternRow(int y) const;
+
+	/**
+	* Same as getBlackPatternRow for column x, read from top to bottom.
+	*/
+	const PatternRow& getBlackPatternColumn(int x) const;
+
 	/**
 	* @return Whether this bitmap can be cropped.
 	*/
@@ -26,6 +26,7 @@
 #endif
 
 #include <algorithm>
+#include <iterator>
 #include <stdexcept>
 #include <utility>
 
@@ -87,7 +88,7 @@ BitMatrix::rotate90()
 	BitMatrix result(height(), width());
 	for (int x = 0; x < width(); ++x) {
 		for (int y = 0; y < height(); ++y) {
-			if (get(x, y)) {
+			if (getUnchecked(x, y)) {
 				result.set(y, width() - x - 1);
 			}
 		}
@@ -126,17 +127,14 @@ BitMatrix::findBoundingBox(int &left, int& top, int& width, int& height, int min
 		return false;
 
 #ifdef ZX_FAST_BIT_STORAGE
+	// scan each row only up to the current left/right bounds, which shrinks the search range quickly
 	for (int y = top; y <= bottom; y++ ) {
-		for (int x = 0; x < left; ++x)
-			if (get(x, y)) {
-				left = x;
-				break;
-			}
-		for (int x = _width-1; x > right; x--)
-			if (get(x, y)) {
-				right = x;
-				break;
-			}
+		const data_t* begin = _bits.data() + y * _width;
+		left = static_cast<int>(std::find_if(begin, begin + left, isSet) - begin);
+		auto rEnd = std::make_reverse_iterator(begin + right + 1);
+		auto rFound = std::find_if(std::make_reverse_iterator(begin + _width), rEnd, isSet);
+		if (rFound != rEnd)
+			right = static_cast<int>(rFound.base() - begin) - 1;
 	}
 #else
 	for (int y = top; y <= bottom; y++)
@@ -216,9 +214,28 @@ BitMatrix::getBottomRightOnBit(int& right, int& bottom) const
 #ifdef ZX_FAST_BIT_STORAGE
 constexpr BitMatrix::data_t BitMatrix::SET_V;
 constexpr BitMatrix::data_t BitMatrix::UNSET_V;
+#endif
+
+// same layout as getPatternRow (see Pattern.h): starts and ends with a (potentially empty) white run
+template <typename GET_BIT>
+static void GetPatternLine(PatternRow& res, int size, GET_BIT getBit)
+{
+	res.assign(1, 0);
+	bool color = false;
+	for (int i = 0; i < size; ++i) {
+		if (getBit(i) != color) {
+			res.push_back(0);
+			color = !color;
+		}
+		++res.back();
+	}
+	if (color)
+		res.push_back(0);
+}
 
 void BitMatrix::getPatternRow(int r, PatternRow& p_row) const
 {
+#ifdef ZX_FAST_BIT_STORAGE
 	auto b_row = row(r);
 #if 0
 	p_row.reserve(64);
@@ -256,8 +273,33 @@ void BitMatrix::getPatternRow(int r, PatternRow& p_row) const
 
 	p_row.resize(intPos - p_row.data() + 1);
 #endif
-}
+#else
+	// jump from one color change to the next by looking at 32 pixels at a time
+	const data_t* words = _bits.data() + r * _rowSize;
+	p_row.assign(1, 0); // first value is number of white pixels
+	bool color = false;
+	for (int x = 0; x < _width;) {
+		int i = x / 32;
+		data_t w = (color ? ~words[i] : words[i]) & (~data_t(0) << (x & 0x1f));
+		while (w == 0 && ++i < _rowSize)
+			w = color ? ~words[i] : words[i];
+		int end = w ? std::min(i * 32 + BitHacks::NumberOfTrailingZeros(w), _width) : _width;
+		p_row.back() += end - x;
+		x = end;
+		if (x < _width) {
+			p_row.push_back(0);
+			color = !color;
+		}
+	}
+	if (color)
+		p_row.push_back(0); // last value is number of white pixels, here 0
 #endif
+}
+
+void BitMatrix::getPatternColumn(int c, PatternRow& p_col) const
+{
+	GetPatternLine(p_col, _height, [this, c](int y) { return getUnchecked(c, y); });
+}
 
 BitMatrix Inflate(BitMatrix&& input, int width, int height, int quietZone)
 {
@@ -279,7 +321,7 @@ BitMatrix Inflate(BitMatrix&& input, int width, int height, int quietZone)
 
 	for (int inputY = 0, outputY = topPadding; inputY < input.height(); ++inputY, outputY += scale) {
 		for (int inputX = 0, outputX = leftPadding; inputX < input.width(); ++inputX, outputX += scale) {
-			if (input.get(inputX, inputY))
+			if (input.getUnchecked(inputX, inputY))
 				result.setRegion(outputX, outputY, scale, scale);
 		}
 	}
@@ -291,6 +333,23 @@ BitMatrix Deflate(const BitMatrix& input, int width, int height, float top, floa
 {
 	BitMatrix result(width, height);
 
+#ifdef ZX_FAST_BIT_STORAGE
+	// Pure, generated images typically have an integer module size. In that case sample with integer strides
+	// directly from the row data, which is equivalent to the PointF based code below (for non-negative offsets).
+	int step = static_cast<int>(subSampling);
+	int x0 = static_cast<int>(left), y0 = static_cast<int>(top);
+	if (step == subSampling && step > 0 && x0 >= 0 && y0 >= 0 && x0 + (width - 1) * step < input.width() &&
+		y0 + (height - 1) * step < input.height()) {
+		for (int y = 0; y < height; y++) {
+			const auto* src = input.row(y0 + y * step).begin() + x0;
+			auto* dst = result.row(y).begin();
+			for (int x = 0; x < width; x++, src += step)
+				dst[x] = *src;
+		}
+		return result;
+	}
+#endif
+
 	for (int y = 0; y < result.height(); y++) {
 		auto yOffset = top + y * subSampling;
 		for (int x = 0; x < result.width(); x++) {
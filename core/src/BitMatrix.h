@@ -64,16 +64,17 @@ class BitMatrix
 	BitMatrix(const BitMatrix&) = default;
 	BitMatrix& operator=(const BitMatrix&) = delete;
 
-	const data_t& get(int i) const {
-#if 1
+	const data_t& get(int i) const { return _bits.at(i); }
+	data_t& get(int i) { return _bits.at(i); }
+
+	const data_t& getUnchecked(int i) const {
+#ifdef ZX_BITMATRIX_BOUNDS_CHECKS
 		return _bits.at(i);
 #else
 		return _bits[i];
 #endif
 	}
 
-	data_t& get(int i) { return const_cast<data_t&>(static_cast<const BitMatrix*>(this)->get(i)); }
-
 public:
 	BitMatrix() = default;
 #ifdef ZX_FAST_BIT_STORAGE
@@ -131,6 +132,18 @@ public:
 #endif
 	}
 
+	/**
+	* Same as get(x, y) but without the bounds check (unless ZX_BITMATRIX_BOUNDS_CHECKS is defined). The caller has to
+	* make sure that (x, y) is inside the matrix, e.g. by testing isIn() first.
+	*/
+	bool getUnchecked(int x, int y) const {
+#ifdef ZX_FAST_BIT_STORAGE
+		return isSet(getUnchecked(y * _width + x));
+#else
+		return ((getUnchecked(y * _rowSize + (x / 32)) >> (x & 0x1f)) & 1) != 0;
+#endif
+	}
+
 	/**
 	* <p>Sets the given bit to true.</p>
 	*
@@ -237,9 +250,15 @@ public:
 
 	bool getBottomRightOnBit(int &right, int& bottom) const;
 
-#ifdef ZX_FAST_BIT_STORAGE
+	/**
+	* Converts row r into the widths of its bars and spaces, see PatternRow in Pattern.h.
+	*/
 	void getPatternRow(int r, std::vector<uint16_t>& p_row) const;
-#endif
+
+	/**
+	* Same as getPatternRow for column c, read from top to bottom.
+	*/
+	void getPatternColumn(int c, std::vector<uint16_t>& p_col) const;
 
 	/**
 	* @return The width of the matrix
@@ -279,6 +298,8 @@ public:
 
 	bool get(PointI p) const { return get(p.x, p.y); }
 	bool get(PointF p) const { return get(PointI(p)); }
+	bool getUnchecked(PointI p) const { return getUnchecked(p.x, p.y); }
+	bool getUnchecked(PointF p) const { return getUnchecked(PointI(p)); }
 	void set(PointI p, bool v = true) { set(p.x, p.y, v); }
 	void set(PointF p, bool v = true) { set(PointI(p), v); }
 };
@@ -65,7 +65,7 @@ public:
 	template <typename T>
 	Value testAt(PointT<T> p) const
 	{
-		return img->isIn(p) ? Value{img->get(p)} : Value{};
+		return img->isIn(p) ? Value{img->getUnchecked(p)} : Value{};
 	}
 
 	bool blackAt(POINT pos) const noexcept { return testAt(pos).isBlack(); }
@@ -94,12 +94,13 @@ std::optional<PointF> CenterOfRings(const BitMatrix& image, PointI center, int r
 	return sum / n;
 }
 
-std::optional<PointF> FinetuneConcentricPatternCenter(const BitMatrix& image, PointF center, int range, int finderPatternSize)
+std::optional<PointF> FinetuneConcentricPatternCenter(const BitMatrix& image, PointF center, int range, int finderPatternSize,
+													  bool centerColor)
 {
 	auto res = CenterOfRings(image, PointI(center), range, finderPatternSize / 2);
-	if (!res || !image.get(*res))
+	if (!res || image.get(*res) != centerColor)
 		res = CenterOfDoubleCross(image, PointI(center), range, finderPatternSize / 2 + 1);
-	if (!res || !image.get(*res))
+	if (!res || image.get(*res) != centerColor)
 		res = center;
 	return res;
 }
@@ -19,23 +19,28 @@
 #include "Pattern.h"
 #include "ZXContainerAlgorithms.h"
 
+#include <limits>
 #include <optional>
+#include <vector>
 
 namespace ZXing {
 
 template <typename T, size_t N>
 static float CenterFromEnd(const std::array<T, N>& pattern, float end)
 {
-	if (N == 5) {
-		float a = pattern[4] + pattern[3] + pattern[2] / 2.f;
-		float b = pattern[4] + (pattern[3] + pattern[2] + pattern[1]) / 2.f;
-		float c = (pattern[4] + pattern[3] + pattern[2] + pattern[1] + pattern[0]) / 2.f;
-		return end - (2 * a + b + c) / 4;
-	} else if (N == 3) {
-		float a = pattern[2] + pattern[1] / 2.f;
-		float b = (pattern[2] + pattern[1] + pattern[0]) / 2.f;
-		return end - (2 * a + b) / 3;
+	static_assert(N % 2 == 1, "concentric patterns have an odd number of bars and spaces");
+	// average the estimates based on each symmetric ring around the center, the innermost one counting twice
+	constexpr int C = N / 2;
+	float outer = 0, inner = pattern[C];
+	for (int i = N - 1; i > C; --i)
+		outer += pattern[i];
+	float sum = 2 * (outer + inner / 2.f);
+	for (int i = 1; i <= C; ++i) {
+		outer -= pattern[C + i];
+		inner += pattern[C - i] + pattern[C + i];
+		sum += outer + inner / 2.f;
 	}
+	return end - sum / (C + 2);
 }
 
 template<typename Pattern, typename Cursor>
@@ -74,7 +79,12 @@ int CheckDirection(BitMatrixCursorF& cur, PointF dir, FinderPattern finderPatter
 
 std::optional<PointF> CenterOfRing(const BitMatrix& image, PointI center, int range, int nth, bool requireCircle = true);
 
-std::optional<PointF> FinetuneConcentricPatternCenter(const BitMatrix& image, PointF center, int range, int finderPatternSize);
+/**
+* Refines the center of a concentric pattern from the rings around it. centerColor is the color of the center module,
+* i.e. true (black) for all but the MaxiCode bull's eye.
+*/
+std::optional<PointF> FinetuneConcentricPatternCenter(const BitMatrix& image, PointF center, int range, int finderPatternSize,
+													  bool centerColor = true);
 
 struct ConcentricPattern : public PointF
 {
@@ -82,7 +92,8 @@ struct ConcentricPattern : public PointF
 };
 
 template <bool RELAXED_THRESHOLD = false, typename FINDER_PATTERN>
-std::optional<ConcentricPattern> LocateConcentricPattern(const BitMatrix& image, FINDER_PATTERN finderPattern, PointF center, int range)
+std::optional<ConcentricPattern> LocateConcentricPattern(const BitMatrix& image, FINDER_PATTERN finderPattern, PointF center, int range,
+														 bool centerColor = true)
 {
 	auto cur = BitMatrixCursorF(image, center, {});
 	int minSpread = image.width(), maxSpread = 0;
@@ -98,12 +109,52 @@ std::optional<ConcentricPattern> LocateConcentricPattern(const BitMatrix& image,
 	if (maxSpread > 5 * minSpread)
 		return {};
 
-	auto newCenter = FinetuneConcentricPatternCenter(image, cur.p, range, finderPattern.size());
+	auto newCenter = FinetuneConcentricPatternCenter(image, cur.p, range, finderPattern.size(), centerColor);
 	if (!newCenter)
 		return {};
 
 	return ConcentricPattern{*newCenter, (maxSpread + minSpread) / 2};
 }
 
+/**
+* Scans every rowStep-th row of image for finderPattern and returns the verified center of each concentric pattern
+* found, see LocateConcentricPattern. getRow(y) returns the PatternRow of row y. Set startsWithSpace if the outermost
+* ring of the pattern is a light one. Verifying a match in a row is the expensive part, so the scan stops after
+* maxChecks of them, whether they passed or not.
+*/
+template <typename FINDER_PATTERN, typename GET_ROW>
+std::vector<ConcentricPattern> FindConcentricPatterns(const BitMatrix& image, FINDER_PATTERN finderPattern,
+													  float minQuietZone, bool startsWithSpace, int rowStep,
+													  GET_ROW getRow, int maxChecks = std::numeric_limits<int>::max())
+{
+	const int c = finderPattern.size() / 2;
+	// the colors alternate from the outermost ring (a space if startsWithSpace) to the center module
+	const bool centerColor = startsWithSpace == (c % 2 == 1);
+	std::vector<ConcentricPattern> res;
+
+	for (int y = rowStep - 1; y < image.height(); y += rowStep) {
+		PatternView next = PatternView(getRow(y)).subView(startsWithSpace);
+
+		while (next = FindLeftGuard(next, 0, finderPattern, minQuietZone), next.isValid()) {
+			PointF p(next.pixelsInFront() + next.sum(c) + next[c] / 2.0, y + 0.5);
+
+			// make sure p is not 'inside' an already found pattern area
+			if (FindIf(res, [p](const auto& old) { return distance(p, old) < old.size / 2; }) == res.end()) {
+				if (maxChecks-- == 0)
+					return res;
+				// 1.5 for very skewed samples
+				auto pattern = LocateConcentricPattern(image, finderPattern, p, Reduce(next) * 3 / 2, centerColor);
+				if (pattern)
+					res.push_back(*pattern);
+			}
+
+			next.skipPair();
+			next.extend();
+		}
+	}
+
+	return res;
+}
+
 } // ZXing
 
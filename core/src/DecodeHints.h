@@ -48,6 +48,7 @@ class DecodeHints
 	bool _assumeGS1 : 1;
 	bool _returnCodabarStartEnd : 1;
 	bool _requireEanAddOnSymbol : 1;
+	bool _trackSymbols : 1;
 	Binarizer _binarizer : 2;
 
 	BarcodeFormats _formats = BarcodeFormat::None;
@@ -58,7 +59,8 @@ public:
 	// bitfields don't get default initialized to 0.
 	DecodeHints()
 		: _tryHarder(1), _tryRotate(1), _isPure(0), _tryCode39ExtendedMode(0), _assumeCode39CheckDigit(0),
-		  _assumeGS1(0), _returnCodabarStartEnd(0), _requireEanAddOnSymbol(0), _binarizer(Binarizer::LocalAverage)
+		  _assumeGS1(0), _returnCodabarStartEnd(0), _requireEanAddOnSymbol(0), _trackSymbols(0),
+		  _binarizer(Binarizer::LocalAverage)
 	{}
 
 #define ZX_PROPERTY(TYPE, GETTER, SETTER) \
@@ -80,6 +82,15 @@ public:
 	/// Set to true if the input contains nothing but a perfectly aligned barcode (generated image)
 	ZX_PROPERTY(bool, isPure, setIsPure)
 
+	/**
+	* Set to true if subsequent images show the same scene, e.g. frames of a video stream. The readers then remember
+	* where they found a symbol and look there first in the next image. They also remember what they learned about
+	* the symbol (e.g. the version and format information of a QR Code) to speed up decoding it again. This only has
+	* an effect if all images are read by the same reader instance (e.g. one MultiFormatReader), not with the
+	* ReadBarcode function.
+	*/
+	ZX_PROPERTY(bool, trackSymbols, setTrackSymbols)
+
 	/// Specifies what character encoding to use when decoding, where applicable.
 	ZX_PROPERTY(std::string, characterSet, setCharacterSet)
 
@@ -17,6 +17,7 @@
 */
 
 #include "BitMatrix.h"
+#include "PerspectiveTransform.h"
 #include "Quadrilateral.h"
 
 #include <utility>
@@ -32,6 +33,7 @@ class DetectorResult
 {
 	BitMatrix _bits;
 	QuadrilateralI _position;
+	PerspectiveTransform _mod2Pix;
 
 	DetectorResult(const DetectorResult&) = delete;
 	DetectorResult& operator=(const DetectorResult&) = delete;
@@ -41,8 +43,8 @@ public:
 	DetectorResult(DetectorResult&&) = default;
 	DetectorResult& operator=(DetectorResult&&) = default;
 
-	DetectorResult(BitMatrix&& bits, QuadrilateralI&& position)
-		: _bits(std::move(bits)), _position(std::move(position))
+	DetectorResult(BitMatrix&& bits, QuadrilateralI&& position, const PerspectiveTransform& mod2Pix = {})
+		: _bits(std::move(bits)), _position(std::move(position)), _mod2Pix(mod2Pix)
 	{}
 
 	const BitMatrix& bits() const & { return _bits; }
@@ -50,6 +52,9 @@ public:
 	const QuadrilateralI& position() const & { return _position; }
 	QuadrilateralI&& position() && { return std::move(_position); }
 
+	/// Transformation from the module grid of bits() into the image (invalid if bits() was not sampled by SampleGrid)
+	const PerspectiveTransform& mod2Pix() const { return _mod2Pix; }
+
 	bool isValid() const { return !_bits.empty(); }
 };
 
@@ -17,6 +17,16 @@
 
 #include "GenericGF.h"
 
+#include <array>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ZX_GF_SSSE3_KERNEL
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define ZX_GF_NEON_KERNEL
+#endif
+
 namespace ZXing {
 
 const GenericGF &
@@ -115,6 +125,97 @@ GenericGF::GenericGF(int primitive, int size, int b) :
 	for (int i = 0; i < size - 1; ++i)
 		_logTable[_expTable[i]] = i;
 	// logTable[0] == 0 but this should never be used
+
+#ifdef ZX_REED_SOLOMON_USE_MORE_MEMORY_FOR_SPEED
+	// for every a = alpha^k: a * x = lo[x & 0xF] ^ hi[x >> 4]
+	if (size == 256) {
+		_mulNibbleTables.resize(255 * 32);
+		for (int k = 0; k < 255; ++k)
+			for (int i = 0; i < 16; ++i) {
+				_mulNibbleTables[32 * k + i] = multiply(_expTable[k], i);
+				_mulNibbleTables[32 * k + 16 + i] = multiply(_expTable[k], i << 4);
+			}
+	}
+#endif
+}
+
+// The kernels evaluate 16 interleaved sub-polynomials at once with Horner's method: lane r of chunk k holds the
+// coefficient of x^(16 * (numChunks - 1 - k) + 15 - r), so every lane gets multiplied by the same d = x^16.
+using HornerKernel = void (*)(const uint8_t* coefs, int numChunks, const uint8_t* mulTables, uint8_t* res);
+
+#ifdef ZX_GF_SSSE3_KERNEL
+__attribute__((target("ssse3")))
+static void HornerSSSE3(const uint8_t* coefs, int numChunks, const uint8_t* mulTables, uint8_t* res)
+{
+	const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mulTables));
+	const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mulTables + 16));
+	const __m128i mask = _mm_set1_epi8(0x0F);
+	__m128i acc = _mm_setzero_si128();
+	for (int k = 0; k < numChunks; ++k) {
+		__m128i l = _mm_shuffle_epi8(lo, _mm_and_si128(acc, mask));
+		__m128i h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(acc, 4), mask));
+		acc = _mm_xor_si128(_mm_xor_si128(l, h), _mm_loadu_si128(reinterpret_cast<const __m128i*>(coefs + 16 * k)));
+	}
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(res), acc);
+}
+#endif
+
+#ifdef ZX_GF_NEON_KERNEL
+static void HornerNEON(const uint8_t* coefs, int numChunks, const uint8_t* mulTables, uint8_t* res)
+{
+	const uint8x16_t lo = vld1q_u8(mulTables);
+	const uint8x16_t hi = vld1q_u8(mulTables + 16);
+	const uint8x16_t mask = vdupq_n_u8(0x0F);
+	uint8x16_t acc = vdupq_n_u8(0);
+	for (int k = 0; k < numChunks; ++k) {
+		uint8x16_t l = vqtbl1q_u8(lo, vandq_u8(acc, mask));
+		uint8x16_t h = vqtbl1q_u8(hi, vshrq_n_u8(acc, 4));
+		acc = veorq_u8(veorq_u8(l, h), vld1q_u8(coefs + 16 * k));
+	}
+	vst1q_u8(res, acc);
+}
+#endif
+
+static HornerKernel SelectHornerKernel()
+{
+#if defined(ZX_GF_SSSE3_KERNEL)
+	return __builtin_cpu_supports("ssse3") ? HornerSSSE3 : nullptr;
+#elif defined(ZX_GF_NEON_KERNEL)
+	return HornerNEON;
+#else
+	return nullptr;
+#endif
+}
+
+bool GenericGF::computeSyndromes(const int* message, int n, int* syndromes, int numSyndromes) const
+{
+	static const HornerKernel kernel = SelectHornerKernel();
+	if (!kernel || _mulNibbleTables.empty() || n > 255)
+		return false;
+
+	// pad with leading zeros (higher order coefficients) to a multiple of 16
+	alignas(16) std::array<uint8_t, 256> coefs = {};
+	int numChunks = (n + 15) / 16;
+	uint8_t* dst = coefs.data() + 16 * numChunks - n;
+	for (int i = 0; i < n; ++i) {
+		if (message[i] & ~0xFF)
+			return false;
+		dst[i] = static_cast<uint8_t>(message[i]);
+	}
+
+	for (int j = 0; j < numSyndromes; ++j) {
+		int logX = (j + _generatorBase) % 255; // evaluate at x = alpha^logX
+		alignas(16) uint8_t acc[16];
+		kernel(coefs.data(), numChunks, _mulNibbleTables.data() + 32 * (16 * logX % 255), acc);
+
+		// combine the lanes: S = sum_r acc[r] * x^(15 - r)
+		int s = 0;
+		for (int r = 0; r < 16; ++r)
+			if (acc[r])
+				s ^= _expTable[(_logTable[acc[r]] + (15 - r) * logX) % 255];
+		syndromes[j] = s;
+	}
+	return true;
 }
 
 } // namespace ZXing
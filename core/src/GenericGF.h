@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <stdexcept>
 #include <vector>
 
@@ -43,6 +44,7 @@ class GenericGF
 	int _generatorBase;
 	std::vector<short> _expTable;
 	std::vector<short> _logTable;
+	std::vector<uint8_t> _mulNibbleTables; // GF(256) only: 16 entry tables for the low and high nibble of a * x
 
 	/**
 	* Create a representation of GF(size) using the given primitive polynomial.
@@ -118,6 +120,21 @@ public:
 		return _size;
 	}
 
+	// unchecked access to the tables for the inner loops of the Reed-Solomon decoder, valid indices for exp are
+	// [0, size - 1) and for log [1, size)
+	const short* expTable() const noexcept { return _expTable.data(); }
+	const short* logTable() const noexcept { return _logTable.data(); }
+
+	/**
+	* Computes the syndromes S[j] = message(alpha^(generatorBase + j)) for j < numSyndromes with a SIMD kernel
+	* (SSSE3 PSHUFB or NEON TBL based multiplication by split-nibble tables), selected at runtime.
+	* The message coefficients are given highest order first.
+	*
+	* @return false if there is no SIMD kernel for this field or CPU, or the message is invalid, in which case the
+	* caller has to compute the syndromes itself
+	*/
+	bool computeSyndromes(const int* message, int n, int* syndromes, int numSyndromes) const;
+
 	int generatorBase() const noexcept {
 		return _generatorBase;
 	}
@@ -48,7 +48,8 @@ DetectorResult SampleGrid(const BitMatrix& image, int width, int height, const P
 #ifdef PRINT_DEBUG
 			log(p, 3);
 #endif
-			if (image.get(p))
+			// p is inside the image as it lies within the quadrilateral spanned by the 4 corners checked above
+			if (image.getUnchecked(p))
 				res.set(x, y);
 		}
 
@@ -60,7 +61,35 @@ DetectorResult SampleGrid(const BitMatrix& image, int width, int height, const P
 	auto projectCorner = [&](PointI p) { return PointI(mod2Pix(PointF(p)) + PointF(0.5, 0.5)); };
 	return {
 		std::move(res),
-		{projectCorner({0, 0}), projectCorner({width, 0}), projectCorner({width, height}), projectCorner({0, height})}};
+		{projectCorner({0, 0}), projectCorner({width, 0}), projectCorner({width, height}), projectCorner({0, height})},
+		mod2Pix};
+}
+
+BitMatrix SampleUncertainModules(const BitMatrix& image, const DetectorResult& grid)
+{
+	const auto& bits = grid.bits();
+	const auto& mod2Pix = grid.mod2Pix();
+	if (!mod2Pix.isValid())
+		return {};
+
+	const PointF probes[] = {{-0.25, 0}, {0.25, 0}, {0, -0.25}, {0, 0.25}};
+
+	BitMatrix res(bits.width(), bits.height());
+	bool hasUncertain = false;
+	for (int y = 0; y < bits.height(); ++y)
+		for (int x = 0; x < bits.width(); ++x) {
+			auto c = centered(PointI{x, y});
+			for (auto d : probes) {
+				auto q = mod2Pix(c + d);
+				if (!image.isIn(q) || image.getUnchecked(q) != bits.get(x, y)) {
+					res.set(x, y);
+					hasUncertain = true;
+					break;
+				}
+			}
+		}
+
+	return hasUncertain ? std::move(res) : BitMatrix();
 }
 
 } // ZXing
@@ -48,4 +48,12 @@ namespace ZXing {
 */
 DetectorResult SampleGrid(const BitMatrix& image, int width, int height, const PerspectiveTransform& mod2Pix);
 
+/**
+ * @brief Finds the modules of a grid returned by SampleGrid that were sampled with low confidence, i.e. where a probe a
+ * quarter of a module away from the center has a different color (or is outside the image). This costs 4 times as
+ * much as the sampling itself, so it is meant to be called only after the error correction failed without erasures.
+ * @return the uncertain modules or an empty matrix if there are none
+ */
+BitMatrix SampleUncertainModules(const BitMatrix& image, const DetectorResult& grid);
+
 } // ZXing
@@ -19,6 +19,7 @@
 
 #include "BarcodeFormat.h"
 #include "DecodeHints.h"
+#include "PatternRowSample.h"
 #include "Result.h"
 #include "aztec/AZReader.h"
 #include "datamatrix/DMReader.h"
@@ -64,10 +65,16 @@ MultiFormatReader::read(const BinaryBitmap& image) const
 {
 	// If we have only one reader in our list, just return whatever that decoded.
 	// This preserves information (e.g. ChecksumError) instead of just returning 'NotFound'.
+	// The sampled rows are extracted on demand and cached in the image, i.e. shared with all readers.
+	PatternRowSample sample(image);
+
 	if (_readers.size() == 1)
-		return _readers.front()->decode(image);
+		return _readers.front()->hasCandidates(sample) ? _readers.front()->decode(image)
+													   : Result(DecodeStatus::NotFound);
 
 	for (const auto& reader : _readers) {
+		if (!reader->hasCandidates(sample))
+			continue;
 		Result r = reader->decode(image);
   		if (r.isValid())
 			return r;
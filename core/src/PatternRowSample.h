@@ -0,0 +1,157 @@
+#pragma once
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BinaryBitmap.h"
+#include "Pattern.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace ZXing {
+
+/**
+ * @brief PatternRowSample gives access to every STEP-th row and column of the black matrix of an image.
+ *
+ * It is the input of the cheap pre-check (Reader::hasCandidates) that allows MultiFormatReader to skip readers of
+ * formats that can not be in the image. The pattern rows come from the cache in BinaryBitmap, i.e. they are shared
+ * with all readers and detectors looking at the same image.
+ */
+class PatternRowSample
+{
+	const BinaryBitmap& _image;
+
+public:
+	// small enough to hit the center 3 modules of a QRCode finder pattern with a module size of 1 pixel
+	static constexpr int STEP = 3;
+
+	explicit PatternRowSample(const BinaryBitmap& image) : _image(image) {}
+
+	int width() const { return _image.width(); }
+	int height() const { return _image.height(); }
+
+	/// the i-th sampled row is the row STEP * i + STEP - 1 of the image
+	int rows() const { return _image.height() / STEP; }
+	const PatternRow& row(int i) const { return _image.getBlackPatternRow(STEP * i + STEP - 1); }
+
+	/// the i-th sampled column (read from top to bottom) is the column STEP * i + STEP - 1 of the image
+	int columns() const { return _image.width() / STEP; }
+	const PatternRow& column(int i) const { return _image.getBlackPatternColumn(STEP * i + STEP - 1); }
+
+	/// true if pred returns true for any of the sampled rows
+	template <typename PRED>
+	bool anyRow(PRED pred) const
+	{
+		for (int y = STEP - 1; y < _image.height(); y += STEP)
+			if (pred(_image.getBlackPatternRow(y)))
+				return true;
+		return false;
+	}
+
+	/// true if pred returns true for any of the sampled columns (read from top to bottom)
+	template <typename PRED>
+	bool anyColumn(PRED pred) const
+	{
+		for (int x = STEP - 1; x < _image.width(); x += STEP)
+			if (pred(_image.getBlackPatternColumn(x)))
+				return true;
+		return false;
+	}
+
+	/// calls func(y, row) for each of the sampled rows
+	template <typename FUNC>
+	void forEachRow(FUNC func) const
+	{
+		for (int y = STEP - 1; y < _image.height(); y += STEP)
+			func(y, _image.getBlackPatternRow(y));
+	}
+
+	/// calls func(x, column) for each of the sampled columns (read from top to bottom)
+	template <typename FUNC>
+	void forEachColumn(FUNC func) const
+	{
+		for (int x = STEP - 1; x < _image.width(); x += STEP)
+			func(x, _image.getBlackPatternColumn(x));
+	}
+};
+
+/**
+ * @brief ContainsCrossedPattern checks whether one of the patterns shows up in one of the sampled rows and in one of
+ * the sampled columns with about the same center and module size, like it does at the center of concentric rings or
+ * squares. Text or 1D barcodes easily contain a pattern in a row or in a column, but rarely in both at the same
+ * spot. If startsWithSpace is set, the patterns are matched against the spaces instead of the bars.
+ */
+template <typename... PATTERNS>
+bool ContainsCrossedPattern(const PatternRowSample& sample, float minQuietZone, bool startsWithSpace,
+							const PATTERNS&... patterns)
+{
+	constexpr int STEP = PatternRowSample::STEP;
+	// the center of the pattern along the row/column, the index of the row/column in the image, the module size and
+	// which of the patterns it is
+	struct Hit { float center; int line; float moduleSize; int pattern; };
+
+	auto findHitsOf = [&](const auto& pattern, int index, int line, const PatternRow& row, std::vector<Hit>& hits) {
+		constexpr int LEN = std::extent_v<decltype(pattern._data)>;
+		if (Size(row) <= LEN)
+			return;
+		// like FindLeftGuard but for all hits in the row. x is the number of pixels in front of the window.
+		auto window = PatternView(row).subView(startsWithSpace, LEN);
+		int x = row[0] + startsWithSpace * row[1];
+		for (; window.isValid(); x += window[0] + window[1], window.skipPair()) {
+			int spaceInPixel = window.isAtFirstBar() ? std::numeric_limits<int>::max() : window[-1];
+			if (float moduleSize = IsPattern(window, pattern, spaceInPixel, minQuietZone))
+				hits.push_back({x + window.sum(LEN / 2) + window[LEN / 2] / 2.f, STEP * line + STEP - 1, moduleSize, index});
+		}
+	};
+	auto findHits = [&](int line, const PatternRow& row, std::vector<Hit>& hits) {
+		int index = 0;
+		(findHitsOf(patterns, index++, line, row, hits), ...);
+	};
+
+	// the columns are only scanned if a row hit is close to them, which is all it takes for most images without a
+	// symbol and allows to stop at the first match for the others
+	std::vector<std::optional<std::vector<Hit>>> columnHits(sample.columns());
+	std::vector<Hit> rowHits;
+	for (int i = 0; i < sample.rows(); ++i) {
+		rowHits.clear();
+		findHits(i, sample.row(i), rowHits);
+		for (auto& r : rowHits) {
+			// a real pattern is crossed by a column no more than about a module from its center
+			float maxDistance = 1.5f * r.moduleSize;
+			int first = std::max(0, static_cast<int>(std::ceil((r.center - maxDistance - STEP + 1) / STEP)));
+			int last = std::min(sample.columns() - 1, static_cast<int>((r.center + maxDistance - STEP + 1) / STEP));
+			for (int j = first; j <= last; ++j) {
+				if (!columnHits[j]) {
+					columnHits[j].emplace();
+					findHits(j, sample.column(j), *columnHits[j]);
+				}
+				for (auto& c : *columnHits[j]) {
+					auto [minSize, maxSize] = std::minmax(r.moduleSize, c.moduleSize);
+					if (r.pattern == c.pattern && maxSize < 1.5f * minSize && std::abs(r.center - c.line) <= 1.5f * minSize &&
+						std::abs(c.center - r.line) <= 1.5f * minSize)
+						return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+} // ZXing
@@ -46,6 +46,7 @@ class PerspectiveTransform
 	static PerspectiveTransform UnitSquareTo(const QuadrilateralF& q);
 
 public:
+	PerspectiveTransform() = default; // invalid
 	PerspectiveTransform(const QuadrilateralF& src, const QuadrilateralF& dst);
 
 	/// Project from the destination space (grid of modules) into the image space (bit matrix)
@@ -19,6 +19,7 @@
 namespace ZXing {
 
 class BinaryBitmap;
+class PatternRowSample;
 class Result;
 
 /**
@@ -55,6 +56,13 @@ public:
 	* @throws FormatException if a potential barcode is found but format is invalid
 	*/
 	virtual Result decode(const BinaryBitmap& image) const = 0;
+
+	/**
+	* Cheap pre-check whether the image may contain a symbol of this format at all, e.g. because a finder pattern
+	* shows up in one of the sampled rows. It must not reject images that decode() would be able to read. Used by
+	* MultiFormatReader to skip readers without candidates.
+	*/
+	virtual bool hasCandidates(const PatternRowSample& /*sample*/) const { return true; }
 };
 
 } // ZXing
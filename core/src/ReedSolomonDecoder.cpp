@@ -22,13 +22,15 @@
 #include "ZXConfig.h"
 
 #include <algorithm>
+#include <array>
 #include <stdexcept>
 #include <utility>
 
 namespace ZXing {
 
 static bool
-RunEuclideanAlgorithm(const GenericGF& field, std::vector<int>&& rCoefs, GenericGFPoly& sigma, GenericGFPoly& omega)
+RunEuclideanAlgorithm(const GenericGF& field, std::vector<int>&& rCoefs, int numErasures, GenericGFPoly& sigma,
+					  GenericGFPoly& omega)
 {
 	int R = Size(rCoefs); // == numECCodeWords
 	GenericGFPoly r(field, std::move(rCoefs));
@@ -47,8 +49,8 @@ RunEuclideanAlgorithm(const GenericGF& field, std::vector<int>&& rCoefs, Generic
 	if (r.degree() >= rLast.degree())
 		swap(r, rLast);
 
-	// Run Euclidean algorithm until r's degree is less than R/2
-	while (r.degree() >= R / 2) {
+	// Run Euclidean algorithm until r's degree is less than (R + numErasures) / 2
+	while (r.degree() >= (R + numErasures) / 2) {
 		swap(tLast, t);
 		swap(rLast, r);
 
@@ -116,9 +118,14 @@ FindErrorMagnitudes(const GenericGF& field, const GenericGFPoly& errorEvaluator,
 	return res;
 }
 
-bool
-ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords)
+static bool
+DecodeEuclidean(const GenericGF& field, std::vector<int>& message, int numECCodeWords, const std::vector<int>& erasures)
 {
+	const int msgLen = Size(message);
+	const int numErasures = Size(erasures);
+	if (numErasures > numECCodeWords)
+		return false;
+
 	GenericGFPoly poly(field, message);
 
 	std::vector<int> syndromes(numECCodeWords);
@@ -129,10 +136,33 @@ ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCo
 	if (std::all_of(syndromes.begin(), syndromes.end(), [](int c) { return c == 0; }))
 		return true;
 
-	ZX_THREAD_LOCAL GenericGFPoly sigma, omega;
+	ZX_THREAD_LOCAL GenericGFPoly sigma, omega, erasureLocator;
+
+	// erasure locator Gamma(x) = prod(1 + X_k * x) with X_k = alpha^(msgLen - 1 - e_k)
+	erasureLocator.setField(field).setMonomial(1);
+	for (int e : erasures) {
+		if (e < 0 || e >= msgLen || msgLen - 1 - e >= field.size() - 1)
+			return false;
+		erasureLocator.multiply(GenericGFPoly(field, {field.exp(msgLen - 1 - e), 1}));
+	}
+
+	// Forney's modified syndromes T(x) = S(x) * Gamma(x) mod x^numECCodeWords (in place, from the highest power down)
+	if (numErasures) {
+		const auto& gamma = erasureLocator.coefficients();
+		const int N = numECCodeWords;
+		for (int i = N - 1; i >= 0; --i) {
+			int t = 0;
+			for (int j = 0; j <= std::min(i, numErasures); ++j)
+				t ^= field.multiply(gamma[numErasures - j], syndromes[N - 1 - (i - j)]);
+			syndromes[N - 1 - i] = t;
+		}
+	}
 
-	if (!RunEuclideanAlgorithm(field, std::move(syndromes), sigma, omega))
+	// the Euclidean algorithm finds the locator of the remaining errors, the errata locator also has the erasures
+	if (!RunEuclideanAlgorithm(field, std::move(syndromes), numErasures, sigma, omega))
 		return false;
+	if (numErasures)
+		sigma.multiply(erasureLocator);
 
 	auto errorLocations = FindErrorLocations(field, sigma);
 	if (errorLocations.empty())
@@ -140,15 +170,199 @@ ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCo
 
 	auto errorMagnitudes = FindErrorMagnitudes(field, omega, errorLocations);
 
-	int msgLen = Size(message);
-	for (int i = 0; i < Size(errorLocations); ++i) {
-		int position = msgLen - 1 - field.log(errorLocations[i]);
-		if (position < 0)
+	for (int i = 0; i < Size(errorLocations); ++i)
+		if (msgLen - 1 - field.log(errorLocations[i]) < 0)
 			return false;
 
-		message[position] ^= errorMagnitudes[i];
+	for (int i = 0; i < Size(errorLocations); ++i)
+		message[msgLen - 1 - field.log(errorLocations[i])] ^= errorMagnitudes[i];
+	return true;
+}
+
+// Capacity of the allocation free decoder below. Larger numbers of EC codewords are only possible with the big Aztec
+// fields and are handled by the Euclidean decoder above.
+constexpr int MAX_EC_CODEWORDS = 256;
+
+namespace {
+
+// Thin wrapper around the exp/log tables of a GenericGF without range checks and with a cheap modulo.
+struct GFTables
+{
+	const short* exp;
+	const short* log;
+	int order; // size of the multiplicative group, i.e. field.size() - 1
+
+	explicit GFTables(const GenericGF& field)
+		: exp(field.expTable()), log(field.logTable()), order(field.size() - 1)
+	{}
+
+	int mod(int i) const noexcept { return i >= order ? i - order : i; } // requires 0 <= i < 2 * order
+	int mul(int a, int b) const noexcept { return a && b ? exp[mod(log[a] + log[b])] : 0; }
+	int div(int a, int b) const noexcept { return a ? exp[mod(log[a] + order - log[b])] : 0; }
+	int alphaPow(int e) const noexcept { return exp[e % order]; }
+};
+
+} // namespace
+
+/**
+ * Errors and erasures decoder without any heap allocations: all syndromes in a single pass over the message, the
+ * errata locator polynomial via Berlekamp-Massey (seeded with the known erasure locations), an incremental Chien
+ * search restricted to the positions inside the message and Forney's formula for the errata magnitudes.
+ */
+static bool
+DecodeBerlekampMassey(const GenericGF& field, std::vector<int>& message, int numECCodeWords,
+					  const std::vector<int>& erasures)
+{
+	const GFTables gf(field);
+	const int n = Size(message);
+	const int N = numECCodeWords;
+	const int b = field.generatorBase();
+	const int numErasures = Size(erasures);
+
+	if (numErasures > N)
+		return false;
+
+	// S[j] = message(alpha^(b + j)), where message[0] is the coefficient of x^(n-1)
+	std::array<int, MAX_EC_CODEWORDS> S = {};
+	if (!field.computeSyndromes(message.data(), n, S.data(), N)) {
+		for (int i = 0; i < n; ++i) {
+			int c = message[i];
+			if (c == 0)
+				continue;
+			if (c > gf.order)
+				return false;
+			int e = (n - 1 - i) % gf.order;
+			int l = gf.mod(gf.log[c] + b * e);
+			for (int j = 0; j < N; ++j, l = gf.mod(l + e))
+				S[j] ^= gf.exp[l];
+		}
+	}
+
+	// if all syndromes are 0 there is no error to correct
+	if (std::all_of(S.begin(), S.begin() + N, [](int c) { return c == 0; }))
+		return true;
+
+	// Berlekamp-Massey: C is the errata locator polynomial, B the last one before a length change. Both start as the
+	// erasure locator prod(1 + X_k * x) with X_k = alpha^e_k, so only the first numErasures syndromes are consumed.
+	std::array<int, MAX_EC_CODEWORDS + 1> C = {1}, B, T;
+	for (int k = 0; k < numErasures; ++k) {
+		if (erasures[k] < 0 || erasures[k] >= n)
+			return false;
+		int X = gf.alphaPow(n - 1 - erasures[k]);
+		for (int i = k + 1; i > 0; --i)
+			C[i] ^= gf.mul(C[i - 1], X);
 	}
+	B = C;
+
+	int L = numErasures, m = 1, lastDiscrepancy = 1;
+	for (int r = numErasures; r < N; ++r) {
+		int d = S[r];
+		for (int i = 1; i <= L; ++i)
+			d ^= gf.mul(C[i], S[r - i]);
+
+		if (d == 0) {
+			++m;
+			continue;
+		}
+
+		int coef = gf.div(d, lastDiscrepancy);
+		bool lengthChange = 2 * L <= r + numErasures;
+		if (lengthChange)
+			T = C;
+		for (int i = 0; i + m <= N; ++i)
+			C[i + m] ^= gf.mul(coef, B[i]);
+		if (lengthChange) {
+			L = r + 1 - L + numErasures;
+			B = T;
+			lastDiscrepancy = d;
+			m = 1;
+		} else {
+			++m;
+		}
+	}
+
+	// every error costs two syndromes, every erasure one
+	if (L == 0 || 2 * L - numErasures > N || C[L] == 0)
+		return false;
+
+	// Chien search: evaluate C at alpha^-e for every position e inside the message. The terms C[j] * alpha^(-j*e)
+	// are kept in log domain and advanced by one multiplication (i.e. addition of logs) per step.
+	std::array<int, MAX_EC_CODEWORDS + 1> termLog, termStep;
+	for (int j = 1; j <= L; ++j) {
+		termLog[j] = C[j] ? gf.log[C[j]] : -1;
+		termStep[j] = gf.order - j % gf.order;
+	}
+
+	std::array<int, MAX_EC_CODEWORDS> errorPos;
+	int numErrors = 0;
+	for (int e = 0; e < n && numErrors < L; ++e) {
+		int v = C[0];
+		for (int j = 1; j <= L; ++j)
+			if (termLog[j] >= 0) {
+				v ^= gf.exp[termLog[j]];
+				termLog[j] = gf.mod(termLog[j] + termStep[j]);
+			}
+		if (v == 0)
+			errorPos[numErrors++] = e;
+	}
+
+	if (numErrors != L)
+		return false; // Error locator degree does not match number of roots
+
+	// Forney: magnitude = X^(1-b) * Omega(X^-1) / C'(X^-1) with X = alpha^e and Omega = S * C mod x^L
+	std::array<int, MAX_EC_CODEWORDS> omega;
+	for (int i = 0; i < L; ++i) {
+		omega[i] = 0;
+		for (int j = 0; j <= i; ++j)
+			omega[i] ^= gf.mul(C[j], S[i - j]);
+	}
+
+	std::array<int, MAX_EC_CODEWORDS> magnitudes;
+	for (int k = 0; k < numErrors; ++k) {
+		int e = errorPos[k];
+		int xInv = gf.alphaPow(gf.order - e % gf.order);
+
+		int num = 0, xPow = 1;
+		for (int i = 0; i < L; ++i, xPow = gf.mul(xPow, xInv))
+			num ^= gf.mul(omega[i], xPow);
+
+		// formal derivative in characteristic 2: only the odd terms remain
+		int denom = 0;
+		int xInv2 = gf.mul(xInv, xInv);
+		xPow = 1;
+		for (int j = 1; j <= L; j += 2, xPow = gf.mul(xPow, xInv2))
+			denom ^= gf.mul(C[j], xPow);
+
+		if (denom == 0)
+			return false;
+
+		int magnitude = gf.div(num, denom);
+		if (b == 0)
+			magnitude = gf.mul(magnitude, gf.alphaPow(e));
+
+		magnitudes[k] = magnitude;
+	}
+
+	// only touch the message once the decoding can not fail anymore
+	for (int k = 0; k < numErrors; ++k)
+		message[n - 1 - errorPos[k]] ^= magnitudes[k];
+
 	return true;
 }
 
+bool
+ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords)
+{
+	return ReedSolomonDecode(field, message, numECCodeWords, {});
+}
+
+bool
+ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords, const std::vector<int>& erasures)
+{
+	if (numECCodeWords <= MAX_EC_CODEWORDS && Size(message) < field.size())
+		return DecodeBerlekampMassey(field, message, numECCodeWords, erasures);
+	else
+		return DecodeEuclidean(field, message, numECCodeWords, erasures);
+}
+
 } // namespace ZXing
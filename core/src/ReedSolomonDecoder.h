@@ -54,4 +54,15 @@ class GenericGF;
  */
 bool ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords);
 
+/**
+ * @brief Same as above but with known erasures, i.e. codewords that are likely wrong (e.g. because they were
+ * sampled with low confidence). An erasure only costs one instead of two error-correction codewords, so up to
+ * 2 * numErrors + numErasures <= numECCodeWords can be corrected. A wrongly reported erasure is harmless apart
+ * from reducing the remaining capacity.
+ *
+ * @param erasures distinct indices into message
+ */
+bool ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords,
+					   const std::vector<int>& erasures);
+
 } // ZXing
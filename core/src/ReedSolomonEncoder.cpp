@@ -18,32 +18,40 @@
 #include "ReedSolomonEncoder.h"
 
 #include "GenericGF.h"
+#include "GenericGFPoly.h"
 
 #include <algorithm>
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <stdexcept>
+#include <utility>
 
 namespace ZXing {
 
-ReedSolomonEncoder::ReedSolomonEncoder(const GenericGF& field)
-: _field(&field)
+/**
+ * Returns the logs of the coefficients of the monic generator polynomial prod(x - alpha^(b + d)), d < degree, without
+ * the leading 1 and highest order first (-1 for a zero coefficient). The result stays valid for the life time of the
+ * process.
+ */
+static const std::vector<int>& GeneratorLogs(const GenericGF& field, int degree)
 {
-	_cachedGenerators.push_back(GenericGFPoly(field, { 1 }));
-}
+	static std::mutex mutex;
+	static std::map<std::pair<const GenericGF*, int>, std::vector<int>> cache;
 
-const GenericGFPoly&
-ReedSolomonEncoder::buildGenerator(int degree)
-{
-	int cachedGenSize = Size(_cachedGenerators);
-	if (degree >= cachedGenSize) {
-		GenericGFPoly lastGenerator = _cachedGenerators.back();
-		for (int d = cachedGenSize; d <= degree; d++) {
-			lastGenerator.multiply(GenericGFPoly(*_field, { 1, _field->exp(d - 1 + _field->generatorBase()) }));
-			_cachedGenerators.push_back(lastGenerator);
-		}
-	}
+	std::lock_guard<std::mutex> lock(mutex);
+	auto& logs = cache[{&field, degree}];
+	if (logs.empty()) {
+		GenericGFPoly generator(field, {1});
+		for (int d = 0; d < degree; d++)
+			generator.multiply(GenericGFPoly(field, {1, field.exp(d + field.generatorBase())}));
 
-	return *std::next(_cachedGenerators.begin(), degree);
+		auto& coefficients = generator.coefficients();
+		logs.reserve(degree);
+		std::transform(coefficients.begin() + 1, coefficients.end(), std::back_inserter(logs),
+					   [&field](int c) { return c ? field.log(c) : -1; });
+	}
+	return logs;
 }
 
 void
@@ -52,14 +60,28 @@ ReedSolomonEncoder::encode(std::vector<int>& message, const int numECCodeWords)
 	if (numECCodeWords == 0 || numECCodeWords >= Size(message))
 		throw std::invalid_argument("Invalid number of error correction code words");
 
-	GenericGFPoly info = GenericGFPoly(*_field, std::vector<int>(message.begin(), message.end() - numECCodeWords));
-	info.multiplyByMonomial(1, numECCodeWords);
-	GenericGFPoly _;
-	info.divide(buildGenerator(numECCodeWords), _);
-	auto& coefficients = info.coefficients();
-	int numZeroCoefficients = numECCodeWords - Size(coefficients);
-	std::fill_n(message.end() - numECCodeWords, numZeroCoefficients, 0);
-	std::copy(coefficients.begin(), coefficients.end(), message.end() - numECCodeWords + numZeroCoefficients);
+	const auto& generator = GeneratorLogs(*_field, numECCodeWords);
+	const short* exp = _field->expTable();
+	const short* log = _field->logTable();
+	const int order = _field->size() - 1;
+
+	// LFSR style polynomial division: the remainder is kept in the error correction part of the message itself,
+	// each data code word is fed back through the (log domain) generator coefficients.
+	auto ec = message.end() - numECCodeWords;
+	std::fill(ec, message.end(), 0);
+	for (auto data = message.begin(); data != ec; ++data) {
+		if (*data < 0 || *data > order)
+			throw std::invalid_argument("Invalid code word value");
+		int feedback = *data ^ ec[0];
+		std::copy(ec + 1, message.end(), ec);
+		message.back() = 0;
+		if (feedback == 0)
+			continue;
+		int feedbackLog = log[feedback];
+		for (int j = 0; j < numECCodeWords; ++j)
+			if (generator[j] >= 0)
+				ec[j] ^= exp[(feedbackLog + generator[j]) % order];
+	}
 }
 
 } // ZXing
@@ -16,30 +16,28 @@
 * limitations under the License.
 */
 
-#include "GenericGFPoly.h"
-
-#include <list>
 #include <vector>
 
 namespace ZXing {
 
+class GenericGF;
+
 // public only for testing purposes
 class ReedSolomonEncoder
 {
 public:
-	explicit ReedSolomonEncoder(const GenericGF& field);
+	explicit ReedSolomonEncoder(const GenericGF& field) : _field(&field) {}
 
 	void encode(std::vector<int>& message, int numECCodeWords);
 
 private:
 	const GenericGF* _field;
-	std::list<GenericGFPoly> _cachedGenerators;
-
-	const GenericGFPoly& buildGenerator(int degree);
 };
 
 /**
  * @brief ReedSolomonEncode replaces the last numECCodeWords code words in message with error correction code words
+ *
+ * The generator polynomials are built once per field and degree and shared between all threads.
  */
 inline void ReedSolomonEncode(const GenericGF& field, std::vector<int>& message, int numECCodeWords)
 {
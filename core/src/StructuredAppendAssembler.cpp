@@ -0,0 +1,95 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "StructuredAppendAssembler.h"
+
+#include "ZXContainerAlgorithms.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace ZXing {
+
+Result StructuredAppendAssembler::add(const Result& result)
+{
+	if (!result.isValid())
+		return Result(DecodeStatus::NotFound);
+
+	const auto& meta = result.metadata();
+	int count = meta.getInt(ResultMetadata::STRUCTURED_APPEND_CODE_COUNT, -1);
+	int seq = meta.getInt(ResultMetadata::STRUCTURED_APPEND_SEQUENCE, -1);
+	int parity = meta.getInt(ResultMetadata::STRUCTURED_APPEND_PARITY, -1);
+
+	// not part of a multi-symbol set -> nothing to assemble
+	if (count <= 1 || seq < 0 || parity < 0)
+		return result;
+
+	if (seq >= count)
+		return Result(DecodeStatus::FormatError);
+
+	auto i = FindIf(_sets, [&](const PartialSet& s) {
+		return s.format == result.format() && s.count == count && s.parity == parity;
+	});
+
+	if (i == _sets.end()) {
+		if (_maxPendingSets <= 0)
+			return Result(DecodeStatus::NotFound);
+		if (Size(_sets) >= _maxPendingSets)
+			_sets.erase(std::min_element(_sets.begin(), _sets.end(),
+										 [](const PartialSet& a, const PartialSet& b) { return a.lastSeen < b.lastSeen; }));
+		_sets.push_back({result.format(), count, parity, _frame, 0, std::vector<Result>(count, Result(DecodeStatus::NotFound))});
+		i = std::prev(_sets.end());
+	}
+
+	i->lastSeen = _frame;
+	auto& part = i->parts[seq];
+	if (!part.isValid()) {
+		part = result;
+		++i->received;
+	}
+
+	if (i->received < count)
+		return Result(DecodeStatus::NotFound);
+
+	auto set = std::move(*i);
+	_sets.erase(i);
+	return merge(std::move(set));
+}
+
+void StructuredAppendAssembler::nextFrame()
+{
+	++_frame;
+	_sets.erase(std::remove_if(_sets.begin(), _sets.end(), [this](const PartialSet& s) { return _frame - s.lastSeen > _maxAge; }),
+				_sets.end());
+}
+
+Result StructuredAppendAssembler::merge(PartialSet&& set) const
+{
+	std::wstring text;
+	ByteArray rawBytes;
+	for (const auto& part : set.parts) {
+		text.append(part.text());
+		rawBytes.insert(rawBytes.end(), part.rawBytes().begin(), part.rawBytes().end());
+	}
+
+	Result res(std::move(text), Position(set.parts.front().position()), set.format, std::move(rawBytes));
+	res.metadata().put(ResultMetadata::STRUCTURED_APPEND_CODE_COUNT, set.count);
+	res.metadata().put(ResultMetadata::STRUCTURED_APPEND_PARITY, set.parity);
+	return res;
+}
+
+} // ZXing
@@ -0,0 +1,78 @@
+#pragma once
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BarcodeFormat.h"
+#include "Result.h"
+
+#include <vector>
+
+namespace ZXing {
+
+/**
+* Collects the parts of structured append symbols (e.g. multi-part QR Codes) as they arrive from
+* subsequent images or video frames and merges them into one Result as soon as the set is complete.
+*
+* Parts are grouped by format, code count and parity. At most maxPendingSets incomplete sets are kept
+* (the least recently updated one is dropped first) and a set that did not receive a part within
+* maxAge frames (see nextFrame()) is discarded.
+*/
+class StructuredAppendAssembler
+{
+public:
+	explicit StructuredAppendAssembler(int maxPendingSets = 4, int maxAge = 30)
+		: _maxPendingSets(maxPendingSets), _maxAge(maxAge)
+	{}
+
+	/**
+	 * @brief Feed a decoded result.
+	 * @return the merged result if this was the last missing part of its set, the result itself if it is not part
+	 * of a structured append set, otherwise a Result with status NotFound.
+	 */
+	Result add(const Result& result);
+
+	/**
+	 * @brief Advance the frame counter and discard sets that have not been updated for more than maxAge frames.
+	 */
+	void nextFrame();
+
+	/**
+	 * @brief Drop all partial sets.
+	 */
+	void clear() { _sets.clear(); }
+
+	int pendingSets() const { return static_cast<int>(_sets.size()); }
+
+private:
+	struct PartialSet
+	{
+		BarcodeFormat format;
+		int count;
+		int parity;
+		int lastSeen;
+		int received = 0;
+		std::vector<Result> parts;
+	};
+
+	Result merge(PartialSet&& set) const;
+
+	std::vector<PartialSet> _sets;
+	int _maxPendingSets;
+	int _maxAge;
+	int _frame = 0;
+};
+
+} // ZXing
@@ -27,8 +27,15 @@
 // of information either in one bit or one byte. Storing it in one byte is considerably faster, while obviously
 // using more memory. The effect of the memory usage while running the TestRunner is virtually invisible.
 // On embedded/mobile systems this might be of importance. Note: the BitMatrix in 'fast' mode still requires
-// only 1/3 of the same image in RGB.
+// only 1/3 of the same image in RGB. For memory bound applications (e.g. large document scans processed in parallel),
+// the compact storage can be selected with the cmake option COMPACT_BIT_STORAGE (which defines ZX_COMPACT_BIT_STORAGE).
+#ifndef ZX_COMPACT_BIT_STORAGE
 #define ZX_FAST_BIT_STORAGE // undef to disable
+#endif
+
+// BitMatrix::getUnchecked() skips the bounds check for callers that already know the position is inside the matrix
+// (e.g. after an isIn() test). Define ZX_BITMATRIX_BOUNDS_CHECKS (cmake option BITMATRIX_BOUNDS_CHECKS) to check them
+// anyway, which is meant for debug and sanitizer builds.
 
 // The Galoir Field abstractions used in Reed-Solomon error correction code can use more memory to eliminate a modulo
 // operation. This improves performance but might not be the best option if RAM is scarce. The effect is a few kB big.
@@ -78,9 +78,10 @@ static int TotalBitsInLayer(int layers, bool compact)
 /**
 * Gets the array of bits from an Aztec Code matrix
 *
+* @param matrix the symbol or a matrix of the same size with per module information (e.g. uncertain modules)
 * @return the array of bits
 */
-static std::vector<bool> ExtractBits(const DetectorResult& ddata)
+static std::vector<bool> ExtractBits(const DetectorResult& ddata, const BitMatrix& matrix)
 {
 	bool compact = ddata.isCompact();
 	int layers = ddata.nbLayers();
@@ -100,7 +101,6 @@ static std::vector<bool> ExtractBits(const DetectorResult& ddata)
 			alignmentMap[origCenter + i] = center + newOffset + 1;
 		}
 	}
-	auto& matrix = ddata.bits();
 	std::vector<bool> rawbits(TotalBitsInLayer(layers, compact));
 	for (int i = 0, rowOffset = 0; i < layers; i++) {
 		int rowSize = (layers - i) * 4 + (compact ? 9 : 12);
@@ -146,10 +146,10 @@ static int ReadCode(const std::vector<bool>& rawbits, int startIndex, int length
 /**
 * <p>Performs RS error correction on an array of bits.</p>
 *
-* @return the corrected array
-* @throws FormatException if the input contains too many errors
+* @return ChecksumError if the input contains too many errors, FormatError if it is malformed
 */
-static bool CorrectBits(const DetectorResult& ddata, const std::vector<bool>& rawbits, std::vector<bool>& correctedBits)
+static DecodeStatus CorrectBits(const DetectorResult& ddata, const std::vector<bool>& rawbits,
+						const std::vector<bool>& uncertainBits, std::vector<bool>& correctedBits)
 {
 	const GenericGF* gf = nullptr;
 	int codewordSize;
@@ -174,7 +174,7 @@ static bool CorrectBits(const DetectorResult& ddata, const std::vector<bool>& ra
 	int numDataCodewords = ddata.nbDatablocks();
 	int numCodewords = Size(rawbits) / codewordSize;
 	if (numCodewords < numDataCodewords) {
-		return false;
+		return DecodeStatus::FormatError;
 	}
 	int offset = rawbits.size() % codewordSize;
 	int numECCodewords = numCodewords - numDataCodewords;
@@ -185,8 +185,16 @@ static bool CorrectBits(const DetectorResult& ddata, const std::vector<bool>& ra
 		dataWords[i] = ReadCode(rawbits, offset, codewordSize);
 	}
 
-	if (!ReedSolomonDecode(*gf, dataWords, numECCodewords))
-		return false;
+	if (!ReedSolomonDecode(*gf, dataWords, numECCodewords)) {
+		// retry with the codewords that contain uncertain modules as erasures
+		std::vector<int> erasures;
+		if (!uncertainBits.empty())
+			for (int i = 0, uOffset = Size(rawbits) % codewordSize; i < numCodewords; i++, uOffset += codewordSize)
+				if (ReadCode(uncertainBits, uOffset, codewordSize))
+					erasures.push_back(i);
+		if (erasures.empty() || !ReedSolomonDecode(*gf, dataWords, numECCodewords, erasures))
+			return DecodeStatus::ChecksumError;
+	}
 
 	// Now perform the unstuffing operation.
 	// First, count how many bits are going to be thrown out as stuffing
@@ -195,7 +203,7 @@ static bool CorrectBits(const DetectorResult& ddata, const std::vector<bool>& ra
 	for (int i = 0; i < numDataCodewords; i++) {
 		int dataWord = dataWords[i];
 		if (dataWord == 0 || dataWord == mask) {
-			return false;
+			return DecodeStatus::FormatError;
 		}
 		else if (dataWord == 1 || dataWord == mask - 1) {
 			stuffedBits++;
@@ -217,7 +225,7 @@ static bool CorrectBits(const DetectorResult& ddata, const std::vector<bool>& ra
 			}
 		}
 	}
-	return true;
+	return DecodeStatus::NoError;
 }
 
 /**
@@ -361,18 +369,18 @@ static ByteArray ConvertBoolArrayToByteArray(const std::vector<bool>& boolArr)
 	return byteArr;
 }
 
-DecoderResult Decoder::Decode(const DetectorResult& detectorResult)
+DecoderResult Decoder::Decode(const DetectorResult& detectorResult, const BitMatrix* uncertain)
 {
-	std::vector<bool> rawbits = ExtractBits(detectorResult);
+	std::vector<bool> rawbits = ExtractBits(detectorResult, detectorResult.bits());
+	std::vector<bool> uncertainBits;
+	if (uncertain && uncertain->height() == detectorResult.bits().height())
+		uncertainBits = ExtractBits(detectorResult, *uncertain);
 	std::vector<bool> correctedBits;
-	if (CorrectBits(detectorResult, rawbits, correctedBits)) {
-		return DecoderResult(ConvertBoolArrayToByteArray(correctedBits),
-							 TextDecoder::FromLatin1(GetEncodedData(correctedBits)))
-		        .setNumBits(Size(correctedBits));
-	}
-	else {
-		return DecodeStatus::FormatError;
-	}
+	if (auto status = CorrectBits(detectorResult, rawbits, uncertainBits, correctedBits); status != DecodeStatus::NoError)
+		return status;
+
+	return DecoderResult(ConvertBoolArrayToByteArray(correctedBits), TextDecoder::FromLatin1(GetEncodedData(correctedBits)))
+		.setNumBits(Size(correctedBits));
 }
 
 } // namespace ZXing::Aztec
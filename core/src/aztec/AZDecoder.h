@@ -18,6 +18,7 @@
 
 namespace ZXing {
 
+class BitMatrix;
 class DecoderResult;
 
 namespace Aztec {
@@ -33,7 +34,11 @@ class DetectorResult;
 class Decoder
 {
 public:
-	static DecoderResult Decode(const DetectorResult& detectorResult);
+	/**
+	 * @param uncertain optional matrix of modules sampled with low confidence, see SampleUncertainModules(). Codewords
+	 * containing such modules are treated as erasures if the error correction fails otherwise.
+	 */
+	static DecoderResult Decode(const DetectorResult& detectorResult, const BitMatrix* uncertain = nullptr);
 };
 
 } // Aztec
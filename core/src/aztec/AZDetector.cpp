@@ -18,16 +18,21 @@
 #include "AZDetector.h"
 
 #include "AZDetectorResult.h"
+#include "BinaryBitmap.h"
 #include "BitHacks.h"
 #include "BitMatrix.h"
+#include "ConcentricFinder.h"
 #include "GenericGF.h"
 #include "GridSampler.h"
+#include "PatternRowSample.h"
 #include "ReedSolomonDecoder.h"
 #include "ResultPoint.h"
 #include "WhiteRectDetector.h"
 
 #include <array>
+#include <limits>
 #include <utility>
+#include <vector>
 
 namespace ZXing::Aztec {
 
@@ -485,25 +490,18 @@ static ZXing::DetectorResult SampleGrid(const BitMatrix& image, const ResultPoin
 										   {topLeft, topRight, bottomRight, bottomLeft}});
 }
 
-DetectorResult Detector::Detect(const BitMatrix& image, bool isMirror, bool isPure)
+/**
+* Reads the mode message around the bull's eye and samples the symbol. In the mirrored case the same corners are
+* traversed in the opposite direction.
+*/
+static DetectorResult SampleBullsEye(const BitMatrix& image, std::array<ResultPoint, 4> bullsEyeCorners, bool compact,
+									 int nbCenterLayers, bool isMirror)
 {
-	// 1. Get the center of the aztec matrix
-	auto pCenter = isPure ? GetMatrixCenterPure(image) : GetMatrixCenter(image);
-
-	// 2. Get the center points of the four diagonal points just outside the bull's eye
-	//  [topRight, bottomRight, bottomLeft, topLeft]
-	std::array<ResultPoint, 4> bullsEyeCorners;
-	bool compact = false;
-	int nbCenterLayers = 0;
-	if (!GetBullsEyeCorners(image, pCenter, bullsEyeCorners, compact, nbCenterLayers)) {
-		return {};
-	}
-
 	if (isMirror) {
 		std::swap(bullsEyeCorners[0], bullsEyeCorners[2]);
 	}
 
-	// 3. Get the size of the matrix and other parameters from the bull's eye
+	// Get the size of the matrix and other parameters from the bull's eye
 	int nbLayers = 0;
 	int nbDataBlocks = 0;
 	int shift = 0;
@@ -511,11 +509,122 @@ DetectorResult Detector::Detect(const BitMatrix& image, bool isMirror, bool isPu
 		return {};
 	}
 
-	// 4. Sample the grid
+	// Sample the grid
 	return {SampleGrid(image, bullsEyeCorners[(shift + 0) % 4], bullsEyeCorners[(shift + 1) % 4],
 					   bullsEyeCorners[(shift + 2) % 4], bullsEyeCorners[(shift + 3) % 4], compact, nbLayers,
 					   nbCenterLayers),
 			compact, nbDataBlocks, nbLayers};
 }
 
+/**
+* Samples the symbol in each mirror state whose mode message passes its parity check, the normal one first. Both are
+* derived from the same bull's eye corners. The mode message of the wrong state may pass by chance, so only decoding
+* the data can tell which one is right.
+*/
+static std::vector<DetectorResult> SampleBullsEye(const BitMatrix& image,
+												  const std::array<ResultPoint, 4>& bullsEyeCorners, bool compact,
+												  int nbCenterLayers)
+{
+	std::vector<DetectorResult> res;
+	for (bool isMirror : {false, true}) {
+		auto r = SampleBullsEye(image, bullsEyeCorners, compact, nbCenterLayers, isMirror);
+		if (r.isValid())
+			res.push_back(std::move(r));
+	}
+	return res;
+}
+
+/**
+* Scans the image rows for the 1:1:1:1:1:1:1 pattern that runs through the center of every bull's eye (the center
+* module plus the three innermost rings on either side) and returns the verified center of each one. The pattern
+* only shows up in the rows crossing the center module, so rowStep must not exceed the smallest module size of interest.
+* At most maxChecks row matches are verified, see FindConcentricPatterns.
+*/
+static std::vector<ConcentricPattern> FindBullsEyes(const BinaryBitmap& bitmap, const BitMatrix& image, int rowStep,
+													int maxChecks)
+{
+	constexpr auto PATTERN = FixedPattern<7, 7>{1, 1, 1, 1, 1, 1, 1};
+
+	// the rows are cached in the bitmap and shared with the other readers
+	auto getRow = [&bitmap](int y) -> const PatternRow& { return bitmap.getBlackPatternRow(y); };
+	// the pattern starts with the white ring around the center module, i.e. with a space
+	return FindConcentricPatterns(image, PATTERN, 0, true, rowStep, getRow, maxChecks);
+}
+
+/**
+* Locates the bull's eye of the Aztec Code in (or near) the center of the image.
+*/
+static bool LocateBullsEye(const BitMatrix& image, bool isPure, std::array<ResultPoint, 4>& bullsEyeCorners,
+						   bool& compact, int& nbCenterLayers)
+{
+	// 1. Get the center of the aztec matrix
+	auto pCenter = isPure ? GetMatrixCenterPure(image) : GetMatrixCenter(image);
+
+	// 2. Get the center points of the four diagonal points just outside the bull's eye
+	//  [topRight, bottomRight, bottomLeft, topLeft]
+	return GetBullsEyeCorners(image, pCenter, bullsEyeCorners, compact, nbCenterLayers);
+}
+
+DetectorResult Detector::Detect(const BitMatrix& image, bool isMirror, bool isPure)
+{
+	std::array<ResultPoint, 4> bullsEyeCorners;
+	bool compact = false;
+	int nbCenterLayers = 0;
+	if (!LocateBullsEye(image, isPure, bullsEyeCorners, compact, nbCenterLayers)) {
+		return {};
+	}
+
+	// 3. Get the size of the matrix and other parameters from the bull's eye and sample the grid
+	return SampleBullsEye(image, bullsEyeCorners, compact, nbCenterLayers, isMirror);
+}
+
+std::vector<DetectorResult> Detector::Detect(const BitMatrix& image, bool isPure)
+{
+	std::array<ResultPoint, 4> bullsEyeCorners;
+	bool compact = false;
+	int nbCenterLayers = 0;
+	if (!LocateBullsEye(image, isPure, bullsEyeCorners, compact, nbCenterLayers)) {
+		return {};
+	}
+
+	return SampleBullsEye(image, bullsEyeCorners, compact, nbCenterLayers);
+}
+
+std::vector<std::vector<DetectorResult>> Detector::DetectMultiple(const BinaryBitmap& bitmap, bool tryHarder)
+{
+	std::vector<std::vector<DetectorResult>> res;
+	auto binImg = bitmap.getBlackMatrix();
+	if (binImg == nullptr)
+		return res;
+	auto& image = *binImg;
+
+	// unless trying harder, only look for symbols with modules of at least 2 pixels and bound the time spent on images
+	// with lots of bull's eye like textures. the symbols of the sample sets are all found within the first 64 checks.
+	int rowStep = tryHarder ? 1 : 2;
+	int maxChecks = tryHarder ? std::numeric_limits<int>::max() : 256;
+	for (auto& center : FindBullsEyes(bitmap, image, rowStep, maxChecks)) {
+		std::array<ResultPoint, 4> bullsEyeCorners;
+		bool compact = false;
+		int nbCenterLayers = 0;
+		if (!GetBullsEyeCorners(image, PointI(center), bullsEyeCorners, compact, nbCenterLayers))
+			continue;
+
+		auto candidates = SampleBullsEye(image, bullsEyeCorners, compact, nbCenterLayers);
+		if (!candidates.empty())
+			res.push_back(std::move(candidates));
+	}
+	return res;
+}
+
+bool Detector::HasBullsEye(const PatternRowSample& sample)
+{
+	// The rows and columns crossing the center module see the pattern of FindBullsEyes (CENTER), at any rotation. The
+	// ones crossing the light ring above or below the center module see it 3 modules wide, surrounded by the dark and
+	// the next light ring on either side (RING), which catches the small unrotated symbols the sampled rows and columns
+	// cross the center module of only for modules of at least STEP pixels.
+	constexpr auto CENTER = FixedPattern<7, 7>{1, 1, 1, 1, 1, 1, 1};
+	constexpr auto RING = FixedPattern<5, 7>{1, 1, 3, 1, 1};
+	return ContainsCrossedPattern(sample, 0, true, CENTER, RING);
+}
+
 } // namespace ZXing::Aztec
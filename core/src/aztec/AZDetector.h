@@ -16,9 +16,13 @@
 * limitations under the License.
 */
 
+#include <vector>
+
 namespace ZXing {
 
+class BinaryBitmap;
 class BitMatrix;
+class PatternRowSample;
 
 namespace Aztec {
 
@@ -42,6 +46,27 @@ public:
 	* @throws NotFoundException if no Aztec Code can be found
 	*/
 	static DetectorResult Detect(const BitMatrix& image, bool isMirror, bool isPure);
+
+	/**
+	* Detects an Aztec Code in an image. The bull's eye is located only once and the symbol is sampled in each mirror
+	* state whose mode message read around it passes its parity check, the normal one first. Only decoding the data
+	* can tell which one is right.
+	*/
+	static std::vector<DetectorResult> Detect(const BitMatrix& image, bool isPure);
+
+	/**
+	* Detects all Aztec Codes in an image by scanning it for their bull's eyes, regardless of where they are located.
+	* Returns the mirror state candidates (see above) of each symbol. Unless tryHarder is set, only every second row
+	* is scanned, which misses symbols with modules smaller than 2 pixels, and the scan stops after the first 256
+	* pattern matches have been verified.
+	*/
+	static std::vector<std::vector<DetectorResult>> DetectMultiple(const BinaryBitmap& image, bool tryHarder);
+
+	/**
+	* Checks whether a sampled row and a sampled column cross something that looks like a bull's eye at about the same
+	* spot.
+	*/
+	static bool HasBullsEye(const PatternRowSample& sample);
 };
 
 } // Aztec
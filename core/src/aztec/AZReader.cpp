@@ -23,6 +23,8 @@
 #include "BinaryBitmap.h"
 #include "DecodeHints.h"
 #include "DecoderResult.h"
+#include "GridSampler.h"
+#include "PatternRowSample.h"
 #include "Result.h"
 
 #include <memory>
@@ -34,6 +36,32 @@ namespace ZXing::Aztec {
 Reader::Reader(const DecodeHints& hints)
 {
 	_isPure = hints.isPure();
+	_tryHarder = hints.tryHarder();
+}
+
+// Only if the error correction fails, retry with the modules sampled with low confidence as erasures
+static DecoderResult DecodeSymbol(const BitMatrix& image, const DetectorResult& detectorResult)
+{
+	auto res = Decoder::Decode(detectorResult);
+	if (res.errorCode() == DecodeStatus::ChecksumError)
+		if (auto uncertain = SampleUncertainModules(image, detectorResult); !uncertain.empty())
+			res = Decoder::Decode(detectorResult, &uncertain);
+	return res;
+}
+
+// Decodes the first of the mirror state candidates of one symbol that passes the error correction
+static DecoderResult DecodeSymbol(const BitMatrix& image, std::vector<DetectorResult>& candidates,
+								  DetectorResult& detectorResult)
+{
+	DecoderResult res = DecodeStatus::NotFound;
+	for (auto& candidate : candidates) {
+		res = DecodeSymbol(image, candidate);
+		if (res.isValid()) {
+			detectorResult = std::move(candidate);
+			break;
+		}
+	}
+	return res;
 }
 
 Result
@@ -44,21 +72,46 @@ Reader::decode(const BinaryBitmap& image) const
 		return Result(DecodeStatus::NotFound);
 	}
 
-	DetectorResult detectResult = Detector::Detect(*binImg, false, _isPure);
-	DecoderResult decodeResult = DecodeStatus::NotFound;
-	if (detectResult.isValid()) {
-		decodeResult = Decoder::Decode(detectResult);
-	}
+	DetectorResult detectResult;
+	auto candidates = Detector::Detect(*binImg, _isPure);
+	DecoderResult decodeResult = DecodeSymbol(*binImg, candidates, detectResult);
 
-	//TODO: don't start detection all over again, just to swap 2 corner points
-	if (!decodeResult.isValid()) {
-		detectResult = Detector::Detect(*binImg, true, _isPure);
-		if (detectResult.isValid()) {
-			decodeResult = Decoder::Decode(detectResult);
+	// the symbol is not located in the center of the image, look for bull's eyes everywhere
+	if (!decodeResult.isValid() && !_isPure) {
+		for (auto& symbolCandidates : Detector::DetectMultiple(image, _tryHarder)) {
+			// skip the symbol in the center if it was found again at the same position, it has already failed above
+			if (!candidates.empty() && symbolCandidates.front().position() == candidates.front().position())
+				continue;
+			decodeResult = DecodeSymbol(*binImg, symbolCandidates, detectResult);
+			if (decodeResult.isValid())
+				break;
 		}
 	}
 
 	return Result(std::move(decodeResult), std::move(detectResult).position(), BarcodeFormat::Aztec);
 }
 
+bool
+Reader::hasCandidates(const PatternRowSample& sample) const
+{
+	return _isPure || Detector::HasBullsEye(sample);
+}
+
+std::list<Result>
+Reader::decodeMultiple(const BinaryBitmap& image) const
+{
+	std::list<Result> results;
+	auto binImg = image.getBlackMatrix();
+	if (binImg == nullptr)
+		return results;
+
+	for (auto& candidates : Detector::DetectMultiple(image, _tryHarder)) {
+		DetectorResult detectorResult;
+		auto decoderResult = DecodeSymbol(*binImg, candidates, detectorResult);
+		if (decoderResult.isValid())
+			results.emplace_back(std::move(decoderResult), std::move(detectorResult).position(), BarcodeFormat::Aztec);
+	}
+	return results;
+}
+
 } // namespace ZXing::Aztec
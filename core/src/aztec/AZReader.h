@@ -18,6 +18,8 @@
 
 #include "Reader.h"
 
+#include <list>
+
 namespace ZXing {
 
 class DecodeHints;
@@ -34,9 +36,16 @@ class Reader : public ZXing::Reader
 public:
 	explicit Reader(const DecodeHints& hints);
 	Result decode(const BinaryBitmap& image) const override;
+	bool hasCandidates(const PatternRowSample& sample) const override;
+
+	/**
+	* Locates and decodes all Aztec codes in an image, wherever they are located.
+	*/
+	std::list<Result> decodeMultiple(const BinaryBitmap& image) const;
 
 private:
 	bool _isPure;
+	bool _tryHarder;
 };
 
 } // Aztec
@@ -156,8 +156,9 @@ BitMatrix BitMatrixFromCodewords(const ByteArray& codewords, int width, int heig
 	return result;
 }
 
-// Extracts the data bits from a BitMatrix that contains alignment patterns.
-static BitMatrix ExtractDataBits(const Version& version, const BitMatrix& bits)
+// Extracts the data bits from a BitMatrix that contains alignment patterns. If mirrored, the module (x, y) of the
+// symbol is read from (width - 1 - y, height - 1 - x) of bits, which keeps the 'L' in place.
+static BitMatrix ExtractDataBits(const Version& version, const BitMatrix& bits, bool mirrored)
 {
 	BitMatrix res(version.dataWidth(), version.dataHeight());
 
@@ -165,7 +166,7 @@ static BitMatrix ExtractDataBits(const Version& version, const BitMatrix& bits)
 		for (int x = 0; x < res.width(); ++x) {
 			int ix = x + 1 + (x / version.dataBlockWidth) * 2;
 			int iy = y + 1 + (y / version.dataBlockHeight) * 2;
-			res.set(x, y, bits.get(ix, iy));
+			res.set(x, y, mirrored ? bits.get(bits.width() - 1 - iy, bits.height() - 1 - ix) : bits.get(ix, iy));
 		}
 
 	return res;
@@ -178,13 +179,14 @@ static BitMatrix ExtractDataBits(const Version& version, const BitMatrix& bits)
 *
 * @return bytes encoded within the Data Matrix Code
 */
-ByteArray CodewordsFromBitMatrix(const BitMatrix& bits)
+ByteArray CodewordsFromBitMatrix(const BitMatrix& bits, bool mirrored)
 {
-	const Version* version = VersionForDimensionsOf(bits);
+	const Version* version =
+		mirrored ? VersionForDimensions(bits.width(), bits.height()) : VersionForDimensions(bits.height(), bits.width());
 	if (version == nullptr)
 		return {};
 
-	BitMatrix dataBits = ExtractDataBits(*version, bits);
+	BitMatrix dataBits = ExtractDataBits(*version, bits, mirrored);
 
 	ByteArray result(version->totalCodewords());
 	auto codeword = result.begin();
@@ -23,7 +23,11 @@ class ByteArray;
 namespace DataMatrix {
 
 BitMatrix BitMatrixFromCodewords(const ByteArray& codewords, int width, int height);
-ByteArray CodewordsFromBitMatrix(const BitMatrix& bits);
+/**
+ * @brief Reads the codewords of a symbol.
+ * @param mirrored read the symbol mirrored along its anti-diagonal (i.e. with the 'L' flipped), without copying it
+ */
+ByteArray CodewordsFromBitMatrix(const BitMatrix& bits, bool mirrored = false);
 
 } // namespace DataMatrix
 } // namespace ZXing
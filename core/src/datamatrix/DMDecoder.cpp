@@ -553,16 +553,25 @@ DecoderResult Decode(ByteArray&& bytes)
 *
 * @param codewordBytes data and error correction codewords
 * @param numDataCodewords number of codewords that are data bytes
+* @param uncertain non-zero for each codeword that contains uncertain modules (or empty)
 * @throws ChecksumException if error correction fails
 */
 static bool
-CorrectErrors(ByteArray& codewordBytes, int numDataCodewords)
+CorrectErrors(ByteArray& codewordBytes, int numDataCodewords, const ByteArray& uncertain)
 {
 	// First read into an array of ints
 	std::vector<int> codewordsInts(codewordBytes.begin(), codewordBytes.end());
 	int numECCodewords = Size(codewordBytes) - numDataCodewords;
-	if (!ReedSolomonDecode(GenericGF::DataMatrixField256(), codewordsInts, numECCodewords))
-		return false;
+	if (!ReedSolomonDecode(GenericGF::DataMatrixField256(), codewordsInts, numECCodewords)) {
+		// retry with the uncertain codewords as erasures
+		std::vector<int> erasures;
+		for (int i = 0; i < Size(uncertain); ++i)
+			if (uncertain[i])
+				erasures.push_back(i);
+		if (erasures.empty() ||
+			!ReedSolomonDecode(GenericGF::DataMatrixField256(), codewordsInts, numECCodewords, erasures))
+			return false;
+	}
 
 	// Copy back into array of bytes -- only need to worry about the bytes that were data
 	// We don't care about errors in the error-correction codewords
@@ -571,16 +580,17 @@ CorrectErrors(ByteArray& codewordBytes, int numDataCodewords)
 	return true;
 }
 
-static DecoderResult DoDecode(const BitMatrix& bits)
+static DecoderResult DoDecode(const BitMatrix& bits, const BitMatrix& uncertain, bool mirrored)
 {
 	// Construct a parser and read version, error-correction level
-	const Version* version = VersionForDimensionsOf(bits);
+	const Version* version =
+		mirrored ? VersionForDimensions(bits.width(), bits.height()) : VersionForDimensions(bits.height(), bits.width());
 	if (version == nullptr) {
 		return DecodeStatus::FormatError;
 	}
 
 	// Read codewords
-	ByteArray codewords = CodewordsFromBitMatrix(bits);
+	ByteArray codewords = CodewordsFromBitMatrix(bits, mirrored);
 	if (codewords.empty())
 		return DecodeStatus::FormatError;
 
@@ -589,6 +599,12 @@ static DecoderResult DoDecode(const BitMatrix& bits)
 	if (dataBlocks.empty())
 		return DecodeStatus::FormatError;
 
+	// Reading the uncertain modules the same way gives a non-zero codeword for every codeword that contains at least
+	// one of them, and the same interleaving puts it at the matching position in its block.
+	std::vector<DataBlock> uncertainBlocks;
+	if (uncertain.width() == bits.width() && uncertain.height() == bits.height())
+		uncertainBlocks = GetDataBlocks(CodewordsFromBitMatrix(uncertain, mirrored), *version);
+
 	// Count total number of data bytes
 	ByteArray resultBytes(TransformReduce(dataBlocks, 0, [](const auto& db) { return db.numDataCodewords; }));
 
@@ -598,7 +614,7 @@ static DecoderResult DoDecode(const BitMatrix& bits)
 		auto& dataBlock = dataBlocks[j];
 		ByteArray& codewordBytes = dataBlock.codewords;
 		int numDataCodewords = dataBlock.numDataCodewords;
-		if (!CorrectErrors(codewordBytes, numDataCodewords))
+		if (!CorrectErrors(codewordBytes, numDataCodewords, uncertainBlocks.empty() ? ByteArray() : uncertainBlocks[j].codewords))
 			return DecodeStatus::ChecksumError;
 
 		for (int i = 0; i < numDataCodewords; i++) {
@@ -611,26 +627,26 @@ static DecoderResult DoDecode(const BitMatrix& bits)
 	return DecodedBitStreamParser::Decode(std::move(resultBytes));
 }
 
-static BitMatrix FlippedL(const BitMatrix& bits)
+DecoderResult Decode(const BitMatrix& bits, const BitMatrix* uncertain)
 {
-	BitMatrix res(bits.height(), bits.width());
-	for (int y = 0; y < res.height(); ++y)
-		for (int x = 0; x < res.width(); ++x)
-			res.set(x, y, bits.get(bits.width() - 1 - y, bits.height() - 1 - x));
-	return res;
-}
+	const BitMatrix noUncertain;
+	if (!uncertain)
+		uncertain = &noUncertain;
 
-DecoderResult Decode(const BitMatrix& bits)
-{
-	auto res = DoDecode(bits);
+	auto res = DoDecode(bits, *uncertain, false);
 	if (res.isValid())
 		return res;
 
+	// The mirrored symbol is only worth a try if the flipped dimensions are a valid version and the error correction
+	// failed (if it succeeded, the orientation was right) or the dimensions are only valid when flipped.
+	bool plausible = res.errorCode() == DecodeStatus::ChecksumError || !VersionForDimensionsOf(bits);
+	if (!plausible || !VersionForDimensions(bits.width(), bits.height()))
+		return res;
+
 	//TODO:
 	// * report mirrored state (see also QRReader)
-	// * unify bit mirroring helper code with QRReader?
 	// * rectangular symbols with the a size of 8 x Y are not supported a.t.m.
-	if (auto mirroredRes = DoDecode(FlippedL(bits)); mirroredRes.isValid())
+	if (auto mirroredRes = DoDecode(bits, *uncertain, true); mirroredRes.isValid())
 		return mirroredRes;
 
 	return res;
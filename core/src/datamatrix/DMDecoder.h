@@ -28,11 +28,13 @@ namespace DataMatrix {
  * to mean a black module.
  *
  * @param bits booleans representing white/black Data Matrix Code modules
+ * @param uncertain optional matrix of modules sampled with low confidence, see SampleUncertainModules(). Codewords
+ * containing such modules are treated as erasures if the error correction fails otherwise.
  * @return text and bytes encoded within the Data Matrix Code
  * @throws FormatException if the Data Matrix Code cannot be decoded
  * @throws ChecksumException if error correction fails
  */
-DecoderResult Decode(const BitMatrix& bits);
+DecoderResult Decode(const BitMatrix& bits, const BitMatrix* uncertain = nullptr);
 
 } // DataMatrix
 } // ZXing
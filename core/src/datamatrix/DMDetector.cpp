@@ -18,11 +18,13 @@
 
 #include "DMDetector.h"
 
+#include "BinaryBitmap.h"
 #include "BitMatrix.h"
 #include "BitMatrixCursor.h"
 #include "DetectorResult.h"
 #include "GridSampler.h"
 #include "LogMatrix.h"
+#include "PatternRowSample.h"
 #include "Point.h"
 #include "RegressionLine.h"
 #include "ResultPoint.h"
@@ -33,6 +35,7 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <map>
 #include <numeric>
@@ -634,7 +637,81 @@ public:
 	}
 };
 
-static DetectorResult Scan(EdgeTracer startTracer, std::array<DMRegressionLine, 4>& lines)
+/**
+* Cheap pre-filter for the edge tracing below: a coarse map of tiles that are crossed by long black runs in the rows and
+* columns of a PatternRowSample, i.e. it only reads the pattern rows and columns that are cached in the BinaryBitmap
+* anyway. The solid 'L' of a symbol consists of two perpendicular legs, so its corner shows up as a tile with a long
+* horizontal and a long vertical run nearby. An image without such a corner can not contain a symbol and tracing only
+* needs to start at transitions close to a long run.
+*/
+class LCandidateMap
+{
+	static constexpr int TILE_SIZE = 8;
+
+	int _width = 0, _height = 0; // in tiles
+	std::vector<uint8_t> _runs;   // per tile: bit i is set if a long run in direction i passes through it
+	bool _hasCorner = false;
+
+	uint8_t runsAround(int tx, int ty) const
+	{
+		uint8_t res = 0;
+		for (int y = std::max(0, ty - 1); y <= std::min(_height - 1, ty + 1); ++y)
+			for (int x = std::max(0, tx - 1); x <= std::min(_width - 1, tx + 1); ++x)
+				res |= _runs[y * _width + x];
+		return res;
+	}
+
+	void findCorner()
+	{
+		for (int ty = 0; ty < _height && !_hasCorner; ++ty)
+			for (int tx = 0; tx < _width && !_hasCorner; ++tx) {
+				auto runs = runsAround(tx, ty);
+				_hasCorner = (runs & 0b0011) == 0b0011 || (runs & 0b1100) == 0b1100;
+			}
+	}
+
+public:
+	/**
+	* A leg is one module thick, i.e. at least MIN_MODULE_SIZE pixels, and at least 8 modules long. If it is rotated by
+	* a <= 45 deg from the horizontal, the rows cross it with runs of MIN_MODULE_SIZE / sin(a) pixels, the other leg
+	* shows the same in the columns. MIN_RUN_LENGTH is what that gives at a = 30 deg. This covers every rotation for
+	* modules of 3 pixels (3 * sqrt(2) ~ 4.2) and longer runs would miss the rotated symbols with the smallest modules.
+	*/
+	static constexpr int MIN_MODULE_SIZE = 2;
+	static constexpr int MIN_RUN_LENGTH = 2 * MIN_MODULE_SIZE; // MIN_MODULE_SIZE / sin(30 deg)
+
+	LCandidateMap(const PatternRowSample& sample, int minRunLength)
+		: _width((sample.width() + TILE_SIZE - 1) / TILE_SIZE), _height((sample.height() + TILE_SIZE - 1) / TILE_SIZE),
+		  _runs(_width * _height, 0)
+	{
+		// mark the tiles covered by the long black runs (odd indices) of a pattern row or column
+		auto markRuns = [&](const PatternRow& line, int pos, bool vertical) {
+			int start = 0;
+			for (size_t i = 0; i < line.size(); start += line[i++]) {
+				if (i % 2 == 0 || line[i] < minRunLength)
+					continue;
+				for (int t = start / TILE_SIZE; t <= (start + line[i] - 1) / TILE_SIZE; ++t)
+					_runs[vertical ? t * _width + pos / TILE_SIZE : (pos / TILE_SIZE) * _width + t] |= 1 << vertical;
+			}
+		};
+
+		sample.forEachRow([&](int y, const PatternRow& row) { markRuns(row, y, false); });
+		sample.forEachColumn([&](int x, const PatternRow& column) { markRuns(column, x, true); });
+
+		findCorner();
+	}
+
+	/// at least one tile with two perpendicular long runs nearby
+	bool hasCorner() const { return _hasCorner; }
+
+	/// a long run passes close by p
+	bool isCandidate(PointF p) const { return runsAround(int(p.x) / TILE_SIZE, int(p.y) / TILE_SIZE) != 0; }
+};
+
+// Steps startTracer along its scan line until a symbol is found. Calling it again with the same tracer continues the
+// search right after the last symbol. If candidates is given, only transitions close to a long black run are traced.
+static DetectorResult Scan(EdgeTracer& startTracer, std::array<DMRegressionLine, 4>& lines,
+						   const LCandidateMap* candidates = nullptr)
 {
 	while (startTracer.step()) {
 		log(startTracer.p);
@@ -643,6 +720,9 @@ static DetectorResult Scan(EdgeTracer startTracer, std::array<DMRegressionLine,
 		if (!startTracer.edgeAtBack().isWhite())
 			continue;
 
+		if (candidates && !candidates->isCandidate(startTracer.p))
+			continue;
+
 		PointF tl, bl, br, tr;
 		auto& [lineL, lineB, lineR, lineT] = lines;
 
@@ -777,7 +857,7 @@ static DetectorResult Scan(EdgeTracer startTracer, std::array<DMRegressionLine,
 	return {};
 }
 
-static DetectorResult DetectNew(const BitMatrix& image, bool tryHarder, bool tryRotate)
+static DetectorResult DetectNew(const BitMatrix& image, bool tryHarder, bool tryRotate, const LCandidateMap& candidates)
 {
 #ifdef PRINT_DEBUG
 	LogMatrixWriter lmw(log, image, 1, "dm-log.pnm");
@@ -813,7 +893,7 @@ static DetectorResult DetectNew(const BitMatrix& image, bool tryHarder, bool try
 			if (!tracer.isIn())
 				break;
 
-			if (auto res = Scan(tracer, lines); res.isValid())
+			if (auto res = Scan(tracer, lines, &candidates); res.isValid())
 				return res;
 
 			if (!tryHarder)
@@ -827,6 +907,61 @@ static DetectorResult DetectNew(const BitMatrix& image, bool tryHarder, bool try
 	return {};
 }
 
+// Returns true if p is inside the convex quadrilateral q (with either orientation).
+static bool IsInside(const QuadrilateralI& q, PointF p)
+{
+	int pos = 0, neg = 0;
+	for (int i = 0; i < 4; ++i) {
+		auto c = cross(PointF(q[(i + 1) % 4] - q[i]), p - PointF(q[i]));
+		pos += c > 0;
+		neg += c < 0;
+	}
+	return pos == 0 || neg == 0;
+}
+
+static std::vector<DetectorResult> ScanAll(const BinaryBitmap& bitmap, const BitMatrix& image, bool tryRotate)
+{
+	LCandidateMap candidates(PatternRowSample(bitmap), LCandidateMap::MIN_RUN_LENGTH);
+	if (!candidates.hasCorner())
+		return {};
+
+	// the history log remembers the traced edges of all scan lines of one direction, so an 'L' that has already been
+	// traced (successfully or not) is not traced again for every scan line that crosses it.
+	BitMatrix history(image.width(), image.height());
+	std::array<DMRegressionLine, 4> lines;
+	std::vector<DetectorResult> results;
+
+	constexpr int minSymbolSize = 8 * 2; // see DetectNew
+
+	for (auto dir : {PointF(-1, 0), PointF(1, 0), PointF(0, -1), PointF(0, 1)}) {
+		auto center = PointF(image.width() / 2, image.height() / 2);
+		auto startPos = centered(center - center * dir + minSymbolSize / 2 * dir);
+
+		EdgeTracer tracer(image, startPos, dir);
+		tracer.history = &history;
+		history.clear();
+
+		for (int i = 1;; ++i) {
+			tracer.p = startPos + i / 2 * minSymbolSize * (i & 1 ? -1 : 1) * tracer.right();
+			if (!tracer.isIn())
+				break;
+
+			// a scan line may cross several symbols
+			for (auto res = Scan(tracer, lines, &candidates); res.isValid(); res = Scan(tracer, lines, &candidates)) {
+				auto& pos = res.position();
+				auto c = PointF(pos[0] + pos[1] + pos[2] + pos[3]) / 4;
+				if (std::none_of(results.begin(), results.end(), [c](auto& r) { return IsInside(r.position(), c); }))
+					results.push_back(std::move(res));
+			}
+		}
+
+		if (!tryRotate)
+			break;
+	}
+
+	return results;
+}
+
 /**
 * This method detects a code in a "pure" image -- that is, pure monochrome image
 * which contains only an unrotated, unskewed, image of a code, with some white border
@@ -867,12 +1002,44 @@ static DetectorResult DetectPure(const BitMatrix& image)
 			{{left, top}, {right, top}, {right, bottom}, {left, bottom}}};
 }
 
-DetectorResult Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, bool isPure)
+std::vector<DetectorResult> DetectMultiple(const BinaryBitmap& bitmap, bool tryRotate, bool isPure)
 {
+	auto binImg = bitmap.getBlackMatrix();
+	if (binImg == nullptr)
+		return {};
+	auto& image = *binImg;
+
+	if (isPure) {
+		std::vector<DetectorResult> res;
+		if (auto r = DetectPure(image); r.isValid())
+			res.push_back(std::move(r));
+		return res;
+	}
+
+	return ScanAll(bitmap, image, tryRotate);
+}
+
+bool HasFinderPattern(const PatternRowSample& sample)
+{
+	return LCandidateMap(sample, LCandidateMap::MIN_RUN_LENGTH).hasCorner();
+}
+
+DetectorResult Detect(const BinaryBitmap& bitmap, bool tryHarder, bool tryRotate, bool isPure)
+{
+	auto binImg = bitmap.getBlackMatrix();
+	if (binImg == nullptr)
+		return {};
+	auto& image = *binImg;
+
 	if (isPure)
 		return DetectPure(image);
 
-	auto result = DetectNew(image, tryHarder, tryRotate);
+	// quick rejection of images that do not contain anything that looks like the 'L' of a symbol
+	LCandidateMap candidates(PatternRowSample(bitmap), LCandidateMap::MIN_RUN_LENGTH);
+	if (!candidates.hasCorner())
+		return {};
+
+	auto result = DetectNew(image, tryHarder, tryRotate, candidates);
 	if (!result.isValid() && tryHarder)
 		result = DetectOld(image);
 	return result;
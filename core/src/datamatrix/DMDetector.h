@@ -16,17 +16,33 @@
 * limitations under the License.
 */
 
+#include <vector>
+
 namespace ZXing {
 
-class BitMatrix;
+class BinaryBitmap;
 class DetectorResult;
+class PatternRowSample;
 
 namespace DataMatrix {
 
 /**
  * @brief Detects a Data Matrix symbol in an image.
  */
-DetectorResult Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, bool isPure);
+DetectorResult Detect(const BinaryBitmap& image, bool tryHarder, bool tryRotate, bool isPure);
+
+/**
+ * @brief Detects all Data Matrix symbols in an image by scanning for 'L'-shaped finder patterns across the whole
+ * image instead of only through its center. Each symbol is reported once.
+ */
+std::vector<DetectorResult> DetectMultiple(const BinaryBitmap& image, bool tryRotate, bool isPure);
+
+/**
+ * @brief HasFinderPattern checks whether the sampled rows and columns contain a long horizontal and a long vertical
+ * black run close to each other, like the corner of the 'L' of a symbol. Used as cheap pre-check by Detect,
+ * DetectMultiple and Reader::hasCandidates.
+ */
+bool HasFinderPattern(const PatternRowSample& sample);
 
 } // DataMatrix
 } // ZXing
@@ -24,6 +24,7 @@
 #include "DecodeHints.h"
 #include "DecoderResult.h"
 #include "DetectorResult.h"
+#include "GridSampler.h"
 #include "Result.h"
 
 #include <utility>
@@ -36,6 +37,16 @@ Reader::Reader(const DecodeHints& hints)
 {
 }
 
+// Only if the error correction fails, retry with the modules sampled with low confidence as erasures
+static DecoderResult DecodeSymbol(const BitMatrix& image, const DetectorResult& detectorResult)
+{
+	auto res = Decode(detectorResult.bits());
+	if (res.errorCode() == DecodeStatus::ChecksumError)
+		if (auto uncertain = SampleUncertainModules(image, detectorResult); !uncertain.empty())
+			res = Decode(detectorResult.bits(), &uncertain);
+	return res;
+}
+
 /**
 * Locates and decodes a Data Matrix code in an image.
 *
@@ -52,11 +63,33 @@ Reader::decode(const BinaryBitmap& image) const
 		return Result(DecodeStatus::NotFound);
 	}
 
-	auto detectorResult = Detect(*binImg, _tryHarder, _tryRotate, _isPure);
+	auto detectorResult = Detect(image, _tryHarder, _tryRotate, _isPure);
 	if (!detectorResult.isValid())
 		return Result(DecodeStatus::NotFound);
 
-	return Result(Decode(detectorResult.bits()), std::move(detectorResult).position(), BarcodeFormat::DataMatrix);
+	return Result(DecodeSymbol(*binImg, detectorResult), std::move(detectorResult).position(), BarcodeFormat::DataMatrix);
+}
+
+bool
+Reader::hasCandidates(const PatternRowSample& sample) const
+{
+	return _isPure || HasFinderPattern(sample);
+}
+
+std::list<Result>
+Reader::decodeMultiple(const BinaryBitmap& image) const
+{
+	std::list<Result> results;
+	auto binImg = image.getBlackMatrix();
+	if (binImg == nullptr)
+		return results;
+
+	for (auto& detectorResult : DetectMultiple(image, _tryRotate, _isPure)) {
+		auto decoderResult = DecodeSymbol(*binImg, detectorResult);
+		if (decoderResult.isValid())
+			results.emplace_back(std::move(decoderResult), std::move(detectorResult).position(), BarcodeFormat::DataMatrix);
+	}
+	return results;
 }
 
 } // namespace ZXing::DataMatrix
@@ -18,6 +18,8 @@
 
 #include "Reader.h"
 
+#include <list>
+
 namespace ZXing {
 
 class DecodeHints;
@@ -35,6 +37,13 @@ class Reader : public ZXing::Reader
 public:
 	explicit Reader(const DecodeHints& hints);
 	Result decode(const BinaryBitmap& image) const override;
+	bool hasCandidates(const PatternRowSample& sample) const override;
+
+	/**
+	* Locates and decodes all Data Matrix codes in an image. Like its PDF417 and Aztec counterparts, this is only
+	* available on the format reader itself: ReadBarcode and MultiFormatReader return a single result.
+	*/
+	std::list<Result> decodeMultiple(const BinaryBitmap& image) const;
 };
 
 } // DataMatrix
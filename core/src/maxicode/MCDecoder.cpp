@@ -78,25 +78,26 @@ static bool CorrectErrors(ByteArray& codewordBytes, int start, int dataCodewords
 */
 namespace DecodedBitStreamParser
 {
-	static const char SHI0 = 0x40;
-	static const char SHI1 = 0x41;
-	static const char SHI2 = 0x42;
-	static const char SHI3 = 0x43;
-	static const char SHI4 = 0x44;
-	static const char TWSA = 0x45;		// two shift A
-	static const char TRSA = 0x46;	// three shift A
-	static const char LCHA = 0x47;		// latch A
-	static const char LCHB = 0x48;		// latch B
-	static const char LOCK = 0x49;
-	static const char ECI  = 0x4A;
-	static const char NS   = 0x4B;
-	static const char PAD  = 0x4C;
+	// the control codes are outside of the range of char, so they can not be confused with one of the characters
+	static const short SHI0 = 0x100;
+	static const short SHI1 = 0x101;
+	static const short SHI2 = 0x102;
+	static const short SHI3 = 0x103;
+	static const short SHI4 = 0x104;
+	static const short TWSA = 0x105;	// two shift A
+	static const short TRSA = 0x106;	// three shift A
+	static const short LCHA = 0x107;	// latch A
+	static const short LCHB = 0x108;	// latch B
+	static const short LOCK = 0x109;
+	static const short ECI  = 0x10A;
+	static const short NS   = 0x10B;
+	static const short PAD  = 0x10C;
 
 	static const char FS = 0x1C;
 	static const char GS = 0x1D;
 	static const char RS = 0x1E;
 
-	const static std::array<char, 0x40> CHARSETS[] = {
+	const static std::array<short, 0x40> CHARSETS[] = {
 		{ // set 0
 			'\n',  'A',  'B',  'C',  'D',  'E',  'F',  'G',  'H',  'I',  'J',  'K',  'L',  'M',  'N',  'O',
 			 'P',  'Q',  'R',  'S',  'T',  'U',  'V',  'W',  'X',  'Y',  'Z',  ECI,   FS,   GS,   RS,   NS,
@@ -162,13 +163,14 @@ namespace DecodedBitStreamParser
 	
 	static std::string GetPostCode3(const ByteArray& bytes)
 	{
+		auto c = [&bytes](const ByteArray& x) { return static_cast<char>(CHARSETS[0].at(GetInt(bytes, x))); };
 		return {
-			CHARSETS[0].at(GetInt(bytes, { 39, 40, 41, 42, 31, 32 })),
-			CHARSETS[0].at(GetInt(bytes, { 33, 34, 35, 36, 25, 26 })),
-			CHARSETS[0].at(GetInt(bytes, { 27, 28, 29, 30, 19, 20 })),
-			CHARSETS[0].at(GetInt(bytes, { 21, 22, 23, 24, 13, 14 })),
-			CHARSETS[0].at(GetInt(bytes, { 15, 16, 17, 18,  7,  8 })),
-			CHARSETS[0].at(GetInt(bytes, { 9,  10, 11, 12,  1,  2 })),
+			c({ 39, 40, 41, 42, 31, 32 }),
+			c({ 33, 34, 35, 36, 25, 26 }),
+			c({ 27, 28, 29, 30, 19, 20 }),
+			c({ 21, 22, 23, 24, 13, 14 }),
+			c({ 15, 16, 17, 18,  7,  8 }),
+			c({ 9,  10, 11, 12,  1,  2 }),
 		};
 	}
 
@@ -197,7 +199,7 @@ namespace DecodedBitStreamParser
 		int set = 0;
 		int lastset = 0;
 		for (int i = start; i < start + len; i++) {
-			char c = CHARSETS[set].at(bytes[i]);
+			short c = CHARSETS[set].at(bytes[i]);
 			switch (c) {
 			case LCHA:
 				set = 0;
@@ -233,16 +235,16 @@ namespace DecodedBitStreamParser
 			case LOCK:
 				shift = -1;
 				break;
+			case PAD:
+			case ECI:
+				break;
 			default:
-				sb.push_back(c);
+				sb.push_back(static_cast<char>(c));
 			}
 			if (shift-- == 0) {
 				set = lastset;
 			}
 		}
-		while (sb.length() > 0 && sb.at(sb.length() - 1) == PAD) {
-			sb.resize(sb.length() - 1);
-		}
 		return sb;
 	}
 
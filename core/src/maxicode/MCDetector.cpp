@@ -0,0 +1,370 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "MCDetector.h"
+
+#include "BinaryBitmap.h"
+#include "BitMatrix.h"
+#include "BitMatrixCursor.h"
+#include "ConcentricFinder.h"
+#include "DetectorResult.h"
+#include "MCBitMatrixParser.h"
+#include "PatternRowSample.h"
+#include "PerspectiveTransform.h"
+#include "Quadrilateral.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+namespace ZXing::MaxiCode {
+
+// All grid coordinates are in units of the horizontal module pitch. The hexagonal modules are arranged in rows that are
+// sqrt(3)/2 apart and every odd row is shifted right by half a module.
+static constexpr double ROW_PITCH = 0.8660254037844386;
+
+static PointF ModuleCenter(int x, int y)
+{
+	return {x + 0.5 + (y & 1) * 0.5, (y + 0.5) * ROW_PITCH};
+}
+
+// The center of the bull's eye is the center of module (14, 16).
+static const PointF BULLS_EYE_CENTER = ModuleCenter(14, 16);
+
+// Radius of the outer edge of the outermost dark ring.
+static constexpr double BULLS_EYE_RADIUS = 4.55;
+
+struct OrientationModule
+{
+	int x, y;
+	bool black;
+};
+
+// The 6 groups of 3 modules around the bull's eye, see the -2 (black) and -1 (white) entries in BITNR.
+static constexpr OrientationModule ORIENTATION_MODULES[] = {
+	{10, 9, true},   {11, 9, true},   {11, 10, true},  // top left
+	{17, 9, false},  {17, 10, false}, {18, 10, false}, // top right
+	{7, 15, true},   {7, 16, false},  {8, 16, true},   // left
+	{20, 16, true},  {21, 16, false}, {20, 17, true},  // right
+	{10, 22, true},  {11, 22, false}, {10, 23, true},  // bottom left
+	{17, 22, true},  {16, 23, false}, {17, 23, true},  // bottom right
+};
+
+/**
+ * Affine mapping from grid coordinates to image coordinates, defined by the image position of the bull's eye center
+ * and the image vectors of the two grid axes.
+ */
+struct GridTransform
+{
+	PointF center, ex, ey;
+
+	PointF operator()(PointF g) const
+	{
+		auto d = g - BULLS_EYE_CENTER;
+		return center + d.x * ex + d.y * ey;
+	}
+};
+
+/**
+ * The 1:1:1:1:?:1:1:1:1 pattern through the center of the bull's eye, starting with the light ring inside the
+ * outermost dark one. The size of the light center varies considerably between printers, hence it is not checked.
+ */
+static constexpr auto PATTERN = FixedSparcePattern<9, 8>{0, 1, 2, 3, 5, 6, 7, 8};
+
+/**
+ * The pattern only shows up in the rows crossing the light center, which is about 1.5 modules high, so rowStep must not
+ * exceed that for the smallest module size of interest.
+ */
+static std::vector<ConcentricPattern> FindBullsEyes(const BinaryBitmap& bitmap, const BitMatrix& image, int rowStep)
+{
+	// the rows are cached in the bitmap and shared with the other readers
+	auto getRow = [&bitmap](int y) -> const PatternRow& { return bitmap.getBlackPatternRow(y); };
+	// Not with the relaxed threshold: that keeps the scan position of a pattern found off its center (e.g. in a row
+	// crossing only the outer rings), which then hides the real center in the following rows.
+	return FindConcentricPatterns(image, PATTERN, 0, true, rowStep, getRow);
+}
+
+/**
+ * Fits an ellipse to the outer edge of the bull's eye and returns the symmetric matrix that maps the unit circle onto
+ * it. This captures the scale and the (affine) skew of the symbol, but not its rotation. Concentric blobs that are not
+ * elliptic (e.g. found in text) are rejected, which is much cheaper than the search for the orientation modules.
+ */
+static std::optional<std::array<double, 3>> FitBullsEye(const BitMatrix& image, const ConcentricPattern& bullsEye)
+{
+	constexpr int N = 16;
+	// maximal deviation of an edge point from the fitted ellipse, relative to its radius. real bull's eyes stay well
+	// below 0.05, the false positives in the test samples are all above 0.2.
+	constexpr double MAX_DEVIATION = 0.1;
+	std::array<PointF, N> edge;
+	// least squares fit of a*x^2 + 2*b*x*y + c*y^2 = 1 via the normal equations
+	double m[3][3] = {}, r[3] = {};
+	for (int i = 0; i < N; ++i) {
+		double alpha = i * 2 * 3.14159265358979 / N;
+		BitMatrixCursorF cur(image, bullsEye, {std::cos(alpha), std::sin(alpha)});
+		if (!cur.stepToEdge(6, bullsEye.size))
+			return {};
+		auto q = edge[i] = cur.p - 0.5 * cur.d - bullsEye;
+		double v[3] = {q.x * q.x, 2 * q.x * q.y, q.y * q.y};
+		for (int j = 0; j < 3; ++j) {
+			for (int k = 0; k < 3; ++k)
+				m[j][k] += v[j] * v[k];
+			r[j] += v[j];
+		}
+	}
+
+	auto det3 = [](double a[3][3]) {
+		return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) - a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+			   a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+	};
+	double det = det3(m);
+	if (std::abs(det) < 1e-12)
+		return {};
+
+	// Cramer's rule
+	std::array<double, 3> conic;
+	for (int j = 0; j < 3; ++j) {
+		double mj[3][3];
+		for (int k = 0; k < 3; ++k)
+			for (int l = 0; l < 3; ++l)
+				mj[k][l] = l == j ? r[k] : m[k][l];
+		conic[j] = det3(mj) / det;
+	}
+
+	auto [a, b, c] = conic;
+	double detM = a * c - b * b;
+	if (a <= 0 || detM <= 0)
+		return {};
+
+	for (auto q : edge)
+		if (std::abs(std::sqrt(a * q.x * q.x + 2 * b * q.x * q.y + c * q.y * q.y) - 1) > MAX_DEVIATION)
+			return {};
+
+	// inverse of the square root of [[a, b], [b, c]]
+	double s = std::sqrt(detM);
+	double t = std::sqrt(a + c + 2 * s);
+	double sa = (a + s) / t, sb = b / t, sc = (c + s) / t;
+	double detS = sa * sc - sb * sb;
+	return std::array<double, 3>{sc / detS, -sb / detS, sa / detS};
+}
+
+static GridTransform MakeTransform(PointF center, const std::array<double, 3>& ellipse, double angle, PointF scale)
+{
+	auto [a, b, c] = ellipse;
+	auto apply = [&](PointF v) { return PointF{a * v.x + b * v.y, b * v.x + c * v.y} / BULLS_EYE_RADIUS; };
+	double cs = std::cos(angle), sn = std::sin(angle);
+	return {center, scale.x * apply({cs, sn}), scale.y * apply({-sn, cs})};
+}
+
+static int CountOrientationMatches(const BitMatrix& image, const GridTransform& mod2Pix)
+{
+	int res = 0;
+	for (auto& m : ORIENTATION_MODULES) {
+		auto p = mod2Pix(ModuleCenter(m.x, m.y));
+		res += image.isIn(p) && image.get(p) == m.black;
+	}
+	return res;
+}
+
+/**
+ * Counts the modules whose color is the same at the center and at points a third of a module away from it. The better
+ * the grid fits the image, the higher the score.
+ */
+template <typename Transform>
+static int GridScore(const BitMatrix& image, const Transform& mod2Pix, double maxDistance = 100)
+{
+	constexpr double o = 1. / 3;
+	int res = 0;
+	for (int y = 0; y < BitMatrixParser::MATRIX_HEIGHT; ++y)
+		for (int x = 0; x < BitMatrixParser::MATRIX_WIDTH; ++x) {
+			auto c = ModuleCenter(x, y);
+			if (distance(c, BULLS_EYE_CENTER) > maxDistance)
+				continue;
+			auto pc = mod2Pix(c);
+			if (!image.isIn(pc))
+				continue;
+			bool color = image.get(pc);
+			for (auto d : {PointF{o, 0}, {-o, 0}, {0, o}, {0, -o}}) {
+				auto p = mod2Pix(c + d);
+				res += image.isIn(p) && image.get(p) == color;
+			}
+		}
+	return res;
+}
+
+static QuadrilateralF GridRect()
+{
+	auto res = Rectangle<PointF>(BitMatrixParser::MATRIX_WIDTH, BitMatrixParser::MATRIX_HEIGHT);
+	for (auto& p : res)
+		p.y *= ROW_PITCH;
+	return res;
+}
+
+/**
+ * Refines the image positions of the 4 corners of the grid, i.e. the perspective transform, by a coordinate descent on
+ * the GridScore with decreasing step sizes. Only the modules up to maxDistance from the bull's eye are considered.
+ */
+static QuadrilateralF RefineCorners(const BitMatrix& image, QuadrilateralF corners, double moduleSize, double maxDistance)
+{
+	const auto gridRect = GridRect();
+	auto score = [&](const QuadrilateralF& q) {
+		PerspectiveTransform mod2Pix(gridRect, q);
+		return mod2Pix.isValid() ? GridScore(image, mod2Pix, maxDistance) : -1;
+	};
+
+	int bestScore = score(corners);
+	for (double step = moduleSize / 2; step > moduleSize / 16; step /= 2) {
+		for (int pass = 0; pass < 8; ++pass) {
+			bool improved = false;
+			// move each corner individually (i < 4) and all of them together (i == 4)
+			for (int i = 0; i < 5; ++i)
+				for (auto d : {PointF{step, 0}, {-step, 0}, {0, step}, {0, -step}}) {
+					auto candidate = corners;
+					for (int j = 0; j < 4; ++j)
+						if (i == j || i == 4)
+							candidate[j] += d;
+					int s = score(candidate);
+					if (s > bestScore) {
+						bestScore = s;
+						corners = candidate;
+						improved = true;
+					}
+				}
+			if (!improved)
+				break;
+		}
+	}
+	return corners;
+}
+
+static DetectorResult SampleGrid(const BitMatrix& image, const QuadrilateralF& corners)
+{
+	for (auto& p : corners)
+		if (!image.isIn(p))
+			return {};
+
+	PerspectiveTransform mod2Pix(GridRect(), corners);
+	if (!mod2Pix.isValid())
+		return {};
+
+	BitMatrix bits(BitMatrixParser::MATRIX_WIDTH, BitMatrixParser::MATRIX_HEIGHT);
+	for (int y = 0; y < bits.height(); ++y)
+		for (int x = 0; x < bits.width(); ++x) {
+			auto p = mod2Pix(ModuleCenter(x, y));
+			if (image.isIn(p) && image.get(p))
+				bits.set(x, y);
+		}
+
+	// mod2Pix maps the coordinates of GridRect(), i.e. not the usual square module grid
+	return {std::move(bits), {corners[0], corners[1], corners[2], corners[3]}, mod2Pix};
+}
+
+static DetectorResult DetectAt(const BitMatrix& image, const ConcentricPattern& bullsEye)
+{
+	auto ellipse = FitBullsEye(image, bullsEye);
+	if (!ellipse)
+		return {};
+
+	// find the rotation by matching the orientation modules, in steps of 1 degree
+	constexpr double DEG = 3.14159265358979 / 180;
+	std::array<int, 360> matches;
+	for (int i = 0; i < 360; ++i)
+		matches[i] = CountOrientationMatches(image, MakeTransform(bullsEye, *ellipse, i * DEG, {1, 1}));
+
+	int best = *std::max_element(matches.begin(), matches.end());
+	if (best < Size(ORIENTATION_MODULES) - 2)
+		return {};
+
+	// take the center of the longest (circular) run of best matching angles
+	int bestStart = 0, bestLen = 0;
+	for (int start = 0; start < 360; ++start) {
+		if (matches[start] != best || matches[(start + 359) % 360] == best)
+			continue;
+		int len = 0;
+		while (len < 360 && matches[(start + len) % 360] == best)
+			++len;
+		if (len > bestLen)
+			bestStart = start, bestLen = len;
+	}
+	double angle = (bestStart + (bestLen - 1) / 2.0) * DEG;
+
+	// The radius of the bull's eye relative to the module pitch varies between printers and the hexagons are often not
+	// regular. Refine the scale along both axes and the rotation by maximizing the number of modules sampled well inside
+	// their boundaries. To not lock onto a neighboring row or column, start with the modules close to the bull's eye.
+	PointF scale = {1, 1};
+	auto refine = [&](double& value, double step, int n) {
+		const double start = value;
+		double bestValue = start;
+		int bestScore = -1;
+		for (int i = -n; i <= n; ++i) {
+			value = start + i * step;
+			int score = GridScore(image, MakeTransform(bullsEye, *ellipse, angle, scale), 9);
+			if (score > bestScore)
+				bestScore = score, bestValue = value;
+		}
+		value = bestValue;
+	};
+	for (int pass = 0; pass < 2; ++pass) {
+		refine(scale.x, 0.01, 6);
+		refine(scale.y, 0.01, 6);
+		refine(angle, 0.5 * DEG, 3);
+	}
+
+	auto affine = MakeTransform(bullsEye, *ellipse, angle, scale);
+	QuadrilateralF corners;
+	auto gridRect = GridRect();
+	for (int i = 0; i < 4; ++i)
+		corners[i] = affine(gridRect[i]);
+
+	return SampleGrid(image, corners);
+}
+
+std::vector<DetectorResult> Detect(const BinaryBitmap& bitmap, bool tryHarder)
+{
+	auto binImg = bitmap.getBlackMatrix();
+	if (binImg == nullptr)
+		return {};
+	auto& image = *binImg;
+
+	std::vector<DetectorResult> res;
+	for (auto& bullsEye : FindBullsEyes(bitmap, image, tryHarder ? 1 : 2))
+		if (auto r = DetectAt(image, bullsEye); r.isValid())
+			res.push_back(std::move(r));
+	return res;
+}
+
+bool HasBullsEye(const PatternRowSample& sample)
+{
+	return ContainsCrossedPattern(sample, 0, true, PATTERN);
+}
+
+DetectorResult RefineGrid(const BitMatrix& image, const DetectorResult& detected)
+{
+	auto corners = GridRect();
+	for (auto& p : corners)
+		p = detected.mod2Pix()(p);
+	auto moduleSize =
+		(distance(corners[0], corners[1]) + distance(corners[3], corners[2])) / (2 * BitMatrixParser::MATRIX_WIDTH);
+
+	// allow for perspective distortion, growing the considered area step by step
+	for (double maxDistance : {9, 13, 17, 100})
+		corners = RefineCorners(image, corners, moduleSize, maxDistance);
+
+	return SampleGrid(image, corners);
+}
+
+} // namespace ZXing::MaxiCode
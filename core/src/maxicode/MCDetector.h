@@ -0,0 +1,50 @@
+#pragma once
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <vector>
+
+namespace ZXing {
+
+class BinaryBitmap;
+class BitMatrix;
+class DetectorResult;
+class PatternRowSample;
+
+namespace MaxiCode {
+
+/**
+ * @brief Detects MaxiCode symbols in an image by locating their concentric-circle bull's eye, estimating the skew from
+ * the shape of the rings and the rotation from the orientation modules around it. Returns one result per bull's eye,
+ * sampled with an affine grid. The bits are laid out as expected by BitMatrixParser (30 x 33, odd rows shifted by half
+ * a module). Unless trying harder, only every other row is scanned for the bull's eye.
+ */
+std::vector<DetectorResult> Detect(const BinaryBitmap& image, bool tryHarder);
+
+/**
+ * @brief Checks whether a sampled row and a sampled column cross something that looks like a bull's eye at about the
+ * same spot.
+ */
+bool HasBullsEye(const PatternRowSample& sample);
+
+/**
+ * @brief Adjusts the grid of a symbol found by Detect to perspective distortion and samples it again. This is expensive,
+ * so it is only worth it if the bits sampled by Detect could not be decoded.
+ */
+DetectorResult RefineGrid(const BitMatrix& image, const DetectorResult& detected);
+
+} // MaxiCode
+} // ZXing
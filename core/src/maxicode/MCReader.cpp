@@ -21,10 +21,15 @@
 #include "BitMatrix.h"
 #include "DecodeHints.h"
 #include "DecoderResult.h"
+#include "DetectorResult.h"
 #include "MCBitMatrixParser.h"
 #include "MCDecoder.h"
+#include "MCDetector.h"
+#include "PatternRowSample.h"
 #include "Result.h"
 
+#include <cstdlib>
+
 namespace ZXing::MaxiCode {
 
 /**
@@ -54,7 +59,26 @@ static BitMatrix ExtractPureBits(const BitMatrix& image)
 	return result;
 }
 
-Reader::Reader(const DecodeHints& hints) : _isPure(hints.isPure()) {}
+// A generated image shows nothing but the symbol on a white background, i.e. the black pixels have a white border
+// around them and their bounding box has about the proportions of a symbol.
+static bool LooksPure(const BitMatrix& image)
+{
+	int left, top, width, height;
+	if (!image.findBoundingBox(left, top, width, height, BitMatrixParser::MATRIX_WIDTH))
+		return false;
+	return left > 0 && top > 0 && left + width < image.width() && top + height < image.height() &&
+		   std::abs(width - height) < width / 8;
+}
+
+static Result DecodePure(const BitMatrix& image)
+{
+	auto bits = ExtractPureBits(image);
+	if (bits.empty())
+		return Result(DecodeStatus::NotFound);
+	return Result(Decoder::Decode(bits), {}, BarcodeFormat::MaxiCode);
+}
+
+Reader::Reader(const DecodeHints& hints) : _tryHarder(hints.tryHarder()), _isPure(hints.isPure()) {}
 
 Result
 Reader::decode(const BinaryBitmap& image) const
@@ -64,13 +88,35 @@ Reader::decode(const BinaryBitmap& image) const
 		return Result(DecodeStatus::NotFound);
 	}
 
-	//TODO: this only works with effectively 'pure' barcodes. Needs proper detector.
-	BitMatrix bits = ExtractPureBits(*binImg);
-	if (bits.empty()) {
-		return Result(DecodeStatus::NotFound);
+	// the 'pure' way is much cheaper than the detection of the bull's eye, so it is tried first if it is likely to work
+	bool looksPure = _isPure || LooksPure(*binImg);
+	if (looksPure) {
+		auto result = DecodePure(*binImg);
+		if (result.isValid() || _isPure)
+			return result;
 	}
 
-	return Result(Decoder::Decode(bits), {}, BarcodeFormat::MaxiCode);
+	for (auto& detectorResult : Detect(image, _tryHarder)) {
+		auto decoderResult = Decoder::Decode(detectorResult.bits());
+		// the correction of perspective distortion is expensive, so only do it if the error correction failed
+		if (decoderResult.errorCode() == DecodeStatus::ChecksumError) {
+			if (auto refined = RefineGrid(*binImg, detectorResult); refined.isValid()) {
+				detectorResult = std::move(refined);
+				decoderResult = Decoder::Decode(detectorResult.bits());
+			}
+		}
+		if (decoderResult.isValid())
+			return Result(std::move(decoderResult), std::move(detectorResult).position(), BarcodeFormat::MaxiCode);
+	}
+
+	// the bull's eye based detection fails for tiny symbols that are still readable in the 'pure' way
+	return looksPure ? Result(DecodeStatus::NotFound) : DecodePure(*binImg);
+}
+
+bool
+Reader::hasCandidates(const PatternRowSample& sample) const
+{
+	return _isPure || HasBullsEye(sample);
 }
 
 } // namespace ZXing::MaxiCode
@@ -26,11 +26,12 @@ namespace MaxiCode {
 
 class Reader : public ZXing::Reader
 {
-	bool _isPure;
+	bool _tryHarder, _isPure;
 
 public:
 	explicit Reader(const DecodeHints& hints);
 	Result decode(const BinaryBitmap& image) const override;
+	bool hasCandidates(const PatternRowSample& sample) const override;
 };
 
 } // MaxiCode
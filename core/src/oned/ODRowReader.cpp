@@ -19,6 +19,7 @@
 #include "BitArray.h"
 #include "Result.h"
 
+#include <iterator>
 #include <memory>
 
 namespace ZXing::OneD {
@@ -36,7 +37,7 @@ Result RowReader::decodeSingleRow(int rowNumber, const BitArray& row) const
 		li = i;
 	}
 	res.push_back(static_cast<PatternRow::value_type>(i - li));
-	if (*(i-1))
+	if (*std::prev(i))
 		res.push_back(0);
 
 	return decodePattern(rowNumber, res, state);
@@ -22,13 +22,36 @@
 namespace ZXing {
 namespace Pdf417 {
 
+int
+BarcodeValue::maxConfidence() const
+{
+	int result = 0;
+	forEach([&](const Entry& entry) { result = std::max(result, entry.count); });
+	return result;
+}
+
 /**
 * Add an occurrence of a value
 */
 void
 BarcodeValue::setValue(int value)
 {
-	_values[value] += 1;
+	for (int i = 0; i < _size && i < INLINE_SIZE; ++i)
+		if (_inline[i].value == value) {
+			_inline[i].count += 1;
+			return;
+		}
+	for (auto& entry : _more)
+		if (entry.value == value) {
+			entry.count += 1;
+			return;
+		}
+
+	if (_size < INLINE_SIZE)
+		_inline[_size] = {value, 1};
+	else
+		_more.push_back({value, 1});
+	_size++;
 }
 
 /**
@@ -39,20 +62,36 @@ std::vector<int>
 BarcodeValue::value() const
 {
 	std::vector<int> result;
-	if (!_values.empty()) {
-		int maxConfidence = std::max_element(_values.begin(), _values.end(), [](auto& l, auto& r) { return l.second < r.second; })->second;
-		for (auto [value, count] : _values)
-			if (count == maxConfidence)
-				result.push_back(value);
-	}
+	int maxCount = maxConfidence();
+	forEach([&](const Entry& entry) {
+		if (entry.count == maxCount)
+			result.push_back(entry.value);
+	});
+	std::sort(result.begin(), result.end());
 	return result;
 }
 
+int
+BarcodeValue::uniqueValue() const
+{
+	int result = -1, resultCount = 0;
+	int maxCount = maxConfidence();
+	forEach([&](const Entry& entry) {
+		if (entry.count == maxCount)
+			result = entry.value, resultCount++;
+	});
+	return resultCount == 1 ? result : -1;
+}
+
 int
 BarcodeValue::confidence(int value) const
 {
-	auto it = _values.find(value);
-	return it != _values.end() ? it->second : 0;
+	int result = 0;
+	forEach([&](const Entry& entry) {
+		if (entry.value == value)
+			result = entry.count;
+	});
+	return result;
 }
 
 } // Pdf417
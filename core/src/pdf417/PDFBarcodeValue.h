@@ -16,7 +16,7 @@
 * limitations under the License.
 */
 
-#include <map>
+#include <array>
 #include <vector>
 
 namespace ZXing {
@@ -27,7 +27,29 @@ namespace Pdf417 {
 */
 class BarcodeValue
 {
-	std::map<int, int> _values;
+	struct Entry
+	{
+		int value = 0;
+		int count = 0;
+	};
+
+	// Almost all cells of a barcode matrix see at most a handful of different values. Keep these inline, so a matrix of
+	// BarcodeValues is a single contiguous block of memory, and only spill over to the heap if there are more.
+	static constexpr int INLINE_SIZE = 3;
+	std::array<Entry, INLINE_SIZE> _inline;
+	std::vector<Entry> _more;
+	int _size = 0;
+
+	template <typename Func>
+	void forEach(Func func) const
+	{
+		for (int i = 0; i < _size && i < INLINE_SIZE; ++i)
+			func(_inline[i]);
+		for (auto& entry : _more)
+			func(entry);
+	}
+
+	int maxConfidence() const;
 
 public:
 	/**
@@ -41,6 +63,13 @@ public:
 	*/
 	std::vector<int> value() const;
 
+	/**
+	* @return the value with the highest occurrence if there is exactly one such value, -1 otherwise
+	*/
+	int uniqueValue() const;
+
+	bool empty() const { return _size == 0; }
+
 	int confidence(int value) const;
 };
 
@@ -19,10 +19,13 @@
 #include "BitArray.h"
 #include "ZXContainerAlgorithms.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
-#include <numeric>
 #include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 namespace ZXing {
 namespace Pdf417 {
@@ -482,9 +485,86 @@ static int GetDecodedCodewordValue(const ModuleBitCountType& moduleBitCount)
 	return CodewordDecoder::GetCodeword(decodedValue) == -1 ? -1 : decodedValue;
 }
 
-static int GetClosestDecodedValue(const ModuleBitCountType& moduleBitCount)
+/**
+* Since the SYMBOL_TABLE is sorted, all symbols that share the same leading bar/space widths form a contiguous range
+* of it. These ranges are the nodes of a prefix tree (one level per bar/space), which allows a branch and bound
+* search for the closest symbol instead of computing the error of every single one of them.
+*/
+struct RatioTreeNode
+{
+	uint16_t begin, end;   // range of symbols sharing the widths up to the level of this node
+	uint16_t firstChild;   // index of the first child, the children are stored consecutively
+	uint8_t childCount;
+};
+
+using RatioTreeType = std::vector<RatioTreeNode>;
+
+static void BuildRatioTree(const RatioTableType& ratioTable, RatioTreeType& tree, int nodeIndex, int level)
+{
+	if (level == CodewordDecoder::BARS_IN_MODULE)
+		return;
+
+	int firstChild = Size(tree);
+	for (int i = tree[nodeIndex].begin, end = tree[nodeIndex].end; i < end;) {
+		int j = i + 1;
+		while (j < end && ratioTable[j][level] == ratioTable[i][level])
+			++j;
+		tree.push_back({static_cast<uint16_t>(i), static_cast<uint16_t>(j), 0, 0});
+		i = j;
+	}
+	tree[nodeIndex].firstChild = static_cast<uint16_t>(firstChild);
+	tree[nodeIndex].childCount = static_cast<uint8_t>(Size(tree) - firstChild);
+
+	for (int i = firstChild, end = Size(tree); i < end; ++i)
+		BuildRatioTree(ratioTable, tree, i, level + 1);
+}
+
+static const RatioTreeType& GetRatioTree()
+{
+	static const RatioTreeType tree = [] {
+		RatioTreeType res = {{0, SYMBOL_COUNT, 0, 0}};
+		BuildRatioTree(GetRatioTable(), res, 0, 0);
+		return res;
+	}();
+	return tree;
+}
+
+struct ClosestMatch
+{
+	float error = std::numeric_limits<float>::max();
+	int index = -1;
+};
+
+static void FindClosestSymbol(const RatioTableType& ratioTable, const RatioTreeType& tree, int nodeIndex, int level, float error,
+							  const std::array<float, CodewordDecoder::BARS_IN_MODULE>& bitCountRatios, ClosestMatch& best)
+{
+	const auto& node = tree[nodeIndex];
+	if (level == CodewordDecoder::BARS_IN_MODULE) {
+		// on a tie the symbol with the lower index wins, just like in a linear scan of the table
+		if (error < best.error || (error == best.error && node.begin < best.index))
+			best = {error, node.begin};
+		return;
+	}
+
+	// accumulate the error in the same order as a linear scan would, so the results are bit-identical
+	std::array<std::pair<float, int>, CodewordDecoder::MODULES_IN_CODEWORD> children;
+	for (int i = 0; i < node.childCount; i++) {
+		int child = node.firstChild + i;
+		float diff = ratioTable[tree[child].begin][level] - bitCountRatios[level];
+		children[i] = {error + diff * diff, child};
+	}
+	std::sort(children.begin(), children.begin() + node.childCount);
+
+	// the error can only grow with every level, so stop as soon as it exceeds the best one found so far
+	for (int i = 0; i < node.childCount && children[i].first <= best.error; i++)
+		FindClosestSymbol(ratioTable, tree, children[i].second, level + 1, children[i].first, bitCountRatios, best);
+}
+
+// not static, so the unit test can compare it with a linear scan of all symbols
+int GetClosestDecodedValue(const ModuleBitCountType& moduleBitCount)
 {
 	static const RatioTableType& ratioTable = GetRatioTable();
+	static const RatioTreeType& ratioTree = GetRatioTree();
 
 	int bitCountSum = Reduce(moduleBitCount);
 	std::array<float, CodewordDecoder::BARS_IN_MODULE> bitCountRatios = {};
@@ -493,24 +573,9 @@ static int GetClosestDecodedValue(const ModuleBitCountType& moduleBitCount)
 			bitCountRatios[i] = moduleBitCount[i] / (float)bitCountSum;
 		}
 	}
-	float bestMatchError = std::numeric_limits<float>::max();
-	int bestMatch = -1;
-	for (size_t j = 0; j < ratioTable.size(); j++) {
-		float error = 0.0f;
-		auto& ratioTableRow = ratioTable[j];
-		for (int k = 0; k < CodewordDecoder::BARS_IN_MODULE; k++) {
-			float diff = ratioTableRow[k] - bitCountRatios[k];
-			error += diff * diff;
-			if (error >= bestMatchError) {
-				break;
-			}
-		}
-		if (error < bestMatchError) {
-			bestMatchError = error;
-			bestMatch = SYMBOL_TABLE[j];
-		}
-	}
-	return bestMatch;
+	ClosestMatch best;
+	FindClosestSymbol(ratioTable, ratioTree, 0, 0, 0.0f, bitCountRatios, best);
+	return best.index == -1 ? -1 : SYMBOL_TABLE[best.index];
 }
 
 int
@@ -20,15 +20,17 @@
 #include "CharacterSetECI.h"
 #include "CharacterSet.h"
 #include "TextDecoder.h"
-#include "ZXBigInteger.h"
 #include "ByteArray.h"
 #include "DecodeStatus.h"
 #include "DecoderResult.h"
 #include "ZXStrConvWorkaround.h"
 #include "ZXTestSupport.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstdint>
+#include <string>
 #include <utility>
 
 namespace ZXing::Pdf417 {
@@ -475,22 +477,28 @@ Remove leading 1 =>  Result is 000213298174000
 */
 static DecodeStatus DecodeBase900toBase10(const std::vector<int>& codewords, int count, std::string& resultString)
 {
-	// Table containing values for the exponent of 900.
-	static const auto EXP900 = []() {
-		std::array<BigInteger, 16> table = {1, 900};
-		for (size_t i = 2; i < table.size(); ++i) {
-			table[i] = table[i - 1] * 900;
-		}
-		return table;
-	}();
-
 	assert(count <= 16);
 
-	BigInteger result;
+	// 16 base 900 digits make at most 48 decimal digits, so the number fits into a fixed array of 'limbs' with 9
+	// decimal digits each (least significant first). Evaluate it with Horner's scheme, which needs no big integers.
+	constexpr uint32_t LIMB_BASE = 1000000000;
+	std::array<uint32_t, 6> limbs = {};
 	for (int i = 0; i < count; i++) {
-		result += EXP900[count - i - 1] * codewords[i];
+		uint64_t carry = codewords[i];
+		for (auto& limb : limbs) {
+			uint64_t value = uint64_t(limb) * 900 + carry;
+			limb = static_cast<uint32_t>(value % LIMB_BASE);
+			carry = value / LIMB_BASE;
+		}
 	}
-	resultString = result.toString();
+
+	auto msl = std::find_if(limbs.rbegin(), limbs.rend(), [](uint32_t limb) { return limb != 0; });
+	resultString = msl != limbs.rend() ? std::to_string(*msl) : "0";
+	for (auto it = msl + (msl != limbs.rend()); it != limbs.rend(); ++it) {
+		auto digits = std::to_string(*it);
+		resultString.append(9 - digits.size(), '0').append(digits);
+	}
+
 	if (!resultString.empty() && resultString.front() == '1') {
 		resultString = resultString.substr(1);
 		return DecodeStatus::NoError;
@@ -21,6 +21,7 @@
 #include "BitMatrix.h"
 #include "ZXNullable.h"
 #include "Pattern.h"
+#include "PatternRowSample.h"
 
 #include <algorithm>
 #include <array>
@@ -107,8 +108,9 @@ PatternMatchVariance(const std::vector<int>& counters, const std::vector<int>& p
 * @param counters array of counters, as long as pattern, to re-use
 * @return start/end horizontal offset of guard pattern, as an array of two ints.
 */
+template <typename Image>
 static bool
-FindGuardPattern(const BitMatrix& matrix, int column, int row, int width, bool whiteFirst, const std::vector<int>& pattern, std::vector<int>& counters, int& startPos, int& endPos)
+FindGuardPattern(const Image& matrix, int column, int row, int width, bool whiteFirst, const std::vector<int>& pattern, std::vector<int>& counters, int& startPos, int& endPos)
 {
 	std::fill(counters.begin(), counters.end(), 0);
 	int patternLength = Size(pattern);
@@ -157,8 +159,9 @@ FindGuardPattern(const BitMatrix& matrix, int column, int row, int width, bool w
 	return false;
 }
 
+template <typename Image>
 static std::array<Nullable<ResultPoint>, 4>&
-FindRowsWithPattern(const BitMatrix& matrix, int height, int width, int startRow, int startColumn, const std::vector<int>& pattern, std::array<Nullable<ResultPoint>, 4>& result)
+FindRowsWithPattern(const Image& matrix, int height, int width, int startRow, int startColumn, const std::vector<int>& pattern, std::array<Nullable<ResultPoint>, 4>& result)
 {
 	bool found = false;
 	int startPos, endPos;
@@ -235,7 +238,8 @@ CopyToResult(std::array<Nullable<ResultPoint>, 8>& result, const std::array<Null
 *           vertices[6] x, y top right codeword area
 *           vertices[7] x, y bottom right codeword area
 */
-static std::array<Nullable<ResultPoint>, 8> FindVertices(const BitMatrix& matrix, int startRow, int startColumn)
+template <typename Image>
+static std::array<Nullable<ResultPoint>, 8> FindVertices(const Image& matrix, int startRow, int startColumn)
 {
 	int width = matrix.width();
 	int height = matrix.height();
@@ -264,7 +268,8 @@ static std::array<Nullable<ResultPoint>, 8> FindVertices(const BitMatrix& matrix
 * @param bitMatrix bit matrix to detect barcodes in
 * @return List of ResultPoint arrays containing the coordinates of found barcodes
 */
-static std::list<std::array<Nullable<ResultPoint>, 8>> DetectBarcode(const BitMatrix& bitMatrix, bool multiple)
+template <typename Image>
+static std::list<std::array<Nullable<ResultPoint>, 8>> DetectBarcode(const Image& bitMatrix, bool multiple)
 {
 	int row = 0;
 	int column = 0;
@@ -313,64 +318,135 @@ static std::list<std::array<Nullable<ResultPoint>, 8>> DetectBarcode(const BitMa
 	return barcodeCoordinates;
 }
 
-#ifdef ZX_FAST_BIT_STORAGE
-bool HasStartPattern(const BitMatrix& m)
-{
-	constexpr FixedPattern<8, 17> START_PATTERN = { 8, 1, 1, 1, 1, 1, 1, 3 };
-	constexpr int minSymbolWidth = 3*8+1; // compact symbol
+constexpr FixedPattern<8, 17> START_GUARD = { 8, 1, 1, 1, 1, 1, 1, 3 };
+constexpr FixedPattern<8, 17> START_GUARD_REVERSED = { 3, 1, 1, 1, 1, 1, 1, 8 };
+constexpr int MIN_SYMBOL_WIDTH = 3*8+1; // compact symbol
 
-	PatternRow row;
+static bool HasStartGuard(const PatternRow& line)
+{
+	return FindLeftGuard(line, MIN_SYMBOL_WIDTH, START_GUARD, 2).isValid();
+}
 
-	for (int r = ROW_STEP; r < m.height(); r += ROW_STEP) {
-		m.getPatternRow(r, row);
+static bool HasReversedStartGuard(const PatternRow& line)
+{
+	// a symbol rotated by 180 degrees has its start pattern on the right, beginning with the space between it and the
+	// row indicator
+	auto isReversedStart = [](const PatternView& window, int) { return IsRightGuard(window, START_GUARD_REVERSED, 2); };
+	auto spaces = PatternView(line).subView(1);
+	return FindLeftGuard<START_GUARD_REVERSED.size()>(spaces, START_GUARD_REVERSED.size(), isReversedStart).isValid();
+}
 
-		if (FindLeftGuard(row, minSymbolWidth, START_PATTERN, 2).isValid())
-			return true;
-		std::reverse(row.begin(), row.end());
-		if (FindLeftGuard(row, minSymbolWidth, START_PATTERN, 2).isValid())
-			return true;
+/**
+* Checks the sampled rows (or columns) for a start pattern, read in the direction it would appear in a symbol that
+* is rotated clockwise by the given degrees. This is a lot cheaper than a full detection or even a rotated copy of the
+* image, so it is done first.
+*/
+static bool HasStartPattern(const PatternRowSample& sample, int rotation)
+{
+	switch (rotation) {
+	case 0: return sample.anyRow(HasStartGuard);
+	case 90: return sample.anyColumn(HasStartGuard);
+	case 180: return sample.anyRow(HasReversedStartGuard);
+	case 270: return sample.anyColumn(HasReversedStartGuard);
+	default: return false;
 	}
-
-	return false;
 }
-#endif
 
 /**
-* <p>Detects a PDF417 Code in an image. Only checks 0 and 180 degree rotations.</p>
+* Read-only view of an image rotated counterclockwise by the given degrees, i.e. the pixels of rotate90() and/or
+* rotate180() of a copy. It lets DetectBarcode scan the other orientations without copying the image.
+*/
+class RotatedImage
+{
+	const BitMatrix& _image;
+	int _rotation;
+
+public:
+	RotatedImage(const BitMatrix& image, int rotation) : _image(image), _rotation(rotation) {}
+
+	int width() const { return _rotation == 90 || _rotation == 270 ? _image.height() : _image.width(); }
+	int height() const { return _rotation == 90 || _rotation == 270 ? _image.width() : _image.height(); }
+
+	bool get(int x, int y) const
+	{
+		switch (_rotation) {
+		case 90: return _image.get(_image.width() - 1 - y, x);
+		case 180: return _image.get(_image.width() - 1 - x, _image.height() - 1 - y);
+		case 270: return _image.get(y, _image.height() - 1 - x);
+		default: return _image.get(x, y);
+		}
+	}
+};
+
+/**
+* <p>Detects PDF417 Codes in an image. Checks 0 and 180 degree rotations and, if tryRotate is set, 90 and 270 degrees.
+* The other orientations are scanned through a RotatedImage and only if there is a start pattern in the respective
+* direction. A rotated copy of the image is created for the decoder only if symbols were found.</p>
 *
 * @param image barcode image to decode
-* @param hints optional hints to detector
-* @param multiple if true, then the image is searched for multiple codes. If false, then at most one code will
-* be found and returned
-* @return {@link PDF417DetectorResult} encapsulating results of detecting a PDF417 code
-* @throws NotFoundException if no PDF417 Code can be found
+* @param multiple if true, then the image is searched for multiple codes. If false, then at most one code per
+* rotation is returned, so the caller can move on to the next rotation if it fails to decode
+* @param tryRotate also look for symbols rotated by 90 and 270 degrees
+* @param results one entry for each rotation in which codes were found
 */
 DecodeStatus
-Detector::Detect(const BinaryBitmap& image, bool multiple, Result& result)
+Detector::Detect(const BinaryBitmap& image, bool multiple, bool tryRotate, std::list<Result>& results)
 {
 	auto binImg = image.getBlackMatrix();
 	if (binImg == nullptr) {
 		return DecodeStatus::NotFound;
 	}
 
-#if defined(ZX_FAST_BIT_STORAGE)
-	if (!HasStartPattern(*binImg))
-		return DecodeStatus::NotFound;
-#endif
-
-	auto barcodeCoordinates = DetectBarcode(*binImg, multiple);
-	if (barcodeCoordinates.empty()) {
-		auto newBits = std::make_shared<BitMatrix>(binImg->copy());
-		newBits->rotate180();
-		binImg = newBits;
-		barcodeCoordinates = DetectBarcode(*binImg, multiple);
+	for (int rotation : {0, 180, 90, 270}) {
+		if (!tryRotate && (rotation == 90 || rotation == 270)) {
+			continue;
+		}
+		if (!HasStartPattern(PatternRowSample(image), rotation)) {
+			continue;
+		}
+		auto barcodeCoordinates = rotation == 0 ? DetectBarcode(*binImg, multiple)
+												: DetectBarcode(RotatedImage(*binImg, rotation), multiple);
+		if (barcodeCoordinates.empty()) {
+			continue;
+		}
+		auto bits = binImg;
+		if (rotation != 0) {
+			// BitMatrix::rotate90() turns the image counterclockwise, i.e. rotates the symbol back to upright
+			auto newBits = std::make_shared<BitMatrix>(binImg->copy());
+			if (rotation == 90 || rotation == 270) {
+				newBits->rotate90();
+			}
+			if (rotation == 180 || rotation == 270) {
+				newBits->rotate180();
+			}
+			bits = newBits;
+		}
+		results.push_back({bits, std::move(barcodeCoordinates), rotation});
 	}
-	if (barcodeCoordinates.empty()) {
-		return DecodeStatus::NotFound;
+	return results.empty() ? DecodeStatus::NotFound : DecodeStatus::NoError;
+}
+
+bool
+Detector::HasCandidates(const PatternRowSample& sample, bool tryRotate)
+{
+	for (int rotation : {0, 180, 90, 270})
+		if ((tryRotate || rotation == 0 || rotation == 180) && HasStartPattern(sample, rotation))
+			return true;
+	return false;
+}
+
+ResultPoint
+Detector::Result::imagePoint(const ResultPoint& p) const
+{
+	// the inverse of the rotation applied in Detect(), bits has the size of the rotated image
+	float w = static_cast<float>(bits->width() - 1);
+	float h = static_cast<float>(bits->height() - 1);
+	switch (rotation) {
+	case 90: return {h - p.y(), p.x()};
+	case 180: return {w - p.x(), h - p.y()};
+	case 270: return {p.y(), w - p.x()};
+	default: return p;
 	}
-	result.points = barcodeCoordinates;
-	result.bits = binImg;
-	return DecodeStatus::NoError;
 }
 
 } // Pdf417
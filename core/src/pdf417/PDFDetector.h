@@ -27,6 +27,7 @@ namespace ZXing {
 
 class BitMatrix;
 class BinaryBitmap;
+class PatternRowSample;
 enum class DecodeStatus;
 
 namespace Pdf417 {
@@ -44,11 +45,21 @@ class Detector
 public:
 	struct Result
 	{
-		std::shared_ptr<const BitMatrix> bits;
+		std::shared_ptr<const BitMatrix> bits; // rotated such that the symbols are upright
 		std::list<std::array<Nullable<ResultPoint>, 8>> points;
+		int rotation = 0; // clockwise rotation of the symbols in the original image
+
+		// maps a point in bits back to the original image
+		ResultPoint imagePoint(const ResultPoint& p) const;
 	};
 
-	static DecodeStatus Detect(const BinaryBitmap& image, bool multiple, Result& result);
+	static DecodeStatus Detect(const BinaryBitmap& image, bool multiple, bool tryRotate, std::list<Result>& results);
+
+	/**
+	* Checks whether one of the sampled rows (or columns if tryRotate is set) contains a start pattern, read in
+	* either direction.
+	*/
+	static bool HasCandidates(const PatternRowSample& sample, bool tryRotate);
 };
 
 } // Pdf417
@@ -21,11 +21,11 @@
 #include "CharacterSet.h"
 #include "CharacterSetECI.h"
 #include "TextEncoder.h"
-#include "ZXBigInteger.h"
 #include "ZXContainerAlgorithms.h"
 
 #include <cstdint>
 #include <algorithm>
+#include <array>
 #include <string>
 #include <stdexcept>
 
@@ -385,21 +385,35 @@ static void EncodeBinary(const std::string& bytes, int startpos, int count, int
 
 static void EncodeNumeric(const std::wstring& msg, int startpos, int count, std::vector<int>& output)
 {
+	// A '1' followed by up to 44 digits fits into 5 'limbs' with 9 decimal digits each (least significant first).
+	constexpr uint32_t LIMB_BASE = 1000000000;
 	int idx = 0;
 	std::vector<int> tmp;
 	tmp.reserve(count / 3 + 1);
-	BigInteger num900(900);
 	while (idx < count) {
 		tmp.clear();
 		int len = std::min(44, count - idx);
-		auto part = L"1" + msg.substr(startpos + idx, len);
 
-		BigInteger bigint, r;
-		BigInteger::TryParse(part, bigint);
+		std::array<uint32_t, 5> limbs = {1};
+		for (int i = 0; i < len; ++i) {
+			uint64_t carry = msg[startpos + idx + i] - '0';
+			for (auto& limb : limbs) {
+				uint64_t value = uint64_t(limb) * 10 + carry;
+				limb = static_cast<uint32_t>(value % LIMB_BASE);
+				carry = value / LIMB_BASE;
+			}
+		}
+
+		// convert to base 900 by repeated long division
 		do {
-			BigInteger::Divide(bigint, num900, bigint, r);
-			tmp.push_back(r.toInt());
-		} while (!bigint.isZero());
+			uint64_t remainder = 0;
+			for (auto it = limbs.rbegin(); it != limbs.rend(); ++it) {
+				uint64_t value = remainder * LIMB_BASE + *it;
+				*it = static_cast<uint32_t>(value / 900);
+				remainder = value % 900;
+			}
+			tmp.push_back(static_cast<int>(remainder));
+		} while (std::any_of(limbs.begin(), limbs.end(), [](uint32_t limb) { return limb != 0; }));
 
 		//Reverse temporary string
 		output.insert(output.end(), tmp.rbegin(), tmp.rend());
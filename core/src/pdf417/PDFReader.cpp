@@ -21,17 +21,20 @@
 #include "PDFScanningDecoder.h"
 #include "PDFCodewordDecoder.h"
 #include "PDFDecoderResultExtra.h"
+#include "PDFBarcodeValue.h"
 #include "DecodeHints.h"
 #include "DecoderResult.h"
 #include "Result.h"
 
 #include "BitMatrixCursor.h"
+#include "Matrix.h"
 #include "BinaryBitmap.h"
 #include "BitArray.h"
 #include "DecodeStatus.h"
 #include "Pattern.h"
 #include "PDFDecodedBitStreamParser.h"
 #include "BitMatrixIO.h"
+#include "ZXTestSupport.h"
 #include <iostream>
 
 #include <vector>
@@ -74,38 +77,7 @@ static int GetMaxCodewordWidth(const std::array<Nullable<ResultPoint>, 8>& p)
 					std::max(GetMaxWidth(p[1], p[5]), GetMaxWidth(p[7], p[3]) * CodewordDecoder::MODULES_IN_CODEWORD / MODULES_IN_STOP_PATTERN));
 }
 
-DecodeStatus DoDecode(const BinaryBitmap& image, bool multiple, std::list<Result>& results)
-{
-	Detector::Result detectorResult;
-	DecodeStatus status = Detector::Detect(image, multiple, detectorResult);
-	if (StatusIsError(status)) {
-		return status;
-	}
-
-	for (const auto& points : detectorResult.points) {
-		DecoderResult decoderResult =
-			ScanningDecoder::Decode(*detectorResult.bits, points[4], points[5], points[6], points[7],
-									GetMinCodewordWidth(points), GetMaxCodewordWidth(points));
-		if (decoderResult.isValid()) {
-			auto point = [&](int i) { return points[i].value(); };
-			Result result(std::move(decoderResult), {point(0), point(2), point(3), point(1)}, BarcodeFormat::PDF417);
-			result.metadata().put(ResultMetadata::ERROR_CORRECTION_LEVEL, decoderResult.ecLevel());
-			if (auto extra = decoderResult.extra()) {
-				result.metadata().put(ResultMetadata::PDF417_EXTRA_METADATA, extra);
-			}
-			results.push_back(result);
-			if (!multiple) {
-				return DecodeStatus::NoError;
-			}
-		}
-		else if (!multiple) {
-			return decoderResult.errorCode();
-		}
-	}
-	return results.empty() ? DecodeStatus::NotFound : DecodeStatus::NoError;
-}
-
-// new implementation (only for isPure use case atm.)
+// new implementation (used for the isPure case and as the fallback for symbols found by the Detector)
 
 using Pattern417 = std::array<uint16_t, 8>;
 
@@ -266,6 +238,148 @@ std::vector<int> ReadCodeWords(BitMatrixCursor<POINT> topCur, SymbolInfo info)
 // forward declaration from PDFScanningDecoder.cpp
 DecoderResult DecodeCodewords(std::vector<int>& codewords, int ecLevel, const std::vector<int>& erasures);
 
+/**
+* Decodes a symbol found by the Detector, given the outline of its start and stop patterns. The symbol may be skewed or
+* perspective distorted, but its rows have to be straight lines. Each line connecting the start pattern with the stop
+* pattern, one per pixel of their height, is read from left to right. Its row indicator tells which row it belongs
+* to and the codewords of all lines of a row are combined by majority vote.
+*/
+ZXING_EXPORT_TEST_ONLY
+DecoderResult DecodeRows(const BitMatrix& image, const std::array<Nullable<ResultPoint>, 8>& points)
+{
+	for (int i : {0, 1, 4, 6, 7})
+		if (points[i] == nullptr)
+			return DecodeStatus::NotFound;
+
+	PointF leftTop = points[0].value(), leftBottom = points[1].value();
+	PointF rightTop = points[6].value(), rightBottom = points[7].value();
+	int colWidth = static_cast<int>(distance(points[0].value(), points[4].value()));
+	int nLines = static_cast<int>(std::max(distance(leftTop, leftBottom), distance(rightTop, rightBottom)));
+	if (colWidth < CodewordDecoder::MODULES_IN_CODEWORD || nLines < 3)
+		return DecodeStatus::NotFound;
+
+	// read all codewords of all lines, the first one being the left row indicator
+	constexpr int MAX_CODEWORDS_IN_LINE = 30 + 2;
+	std::vector<std::vector<CodeWord>> lines;
+	lines.reserve(nLines);
+	for (int i = 0; i < nLines; ++i) {
+		float t = (i + 0.5f) / nLines;
+		auto left = leftTop + t * (leftBottom - leftTop);
+		auto right = rightTop + t * (rightBottom - rightTop);
+		double lineLength = distance(left, right);
+		BitMatrixCursorF cur(image, left, right - left);
+		// skip start pattern
+		if (!cur.stepToEdge(8 + cur.isWhite(), colWidth * 3 / 2))
+			continue;
+		auto& line = lines.emplace_back();
+		while (Size(line) < MAX_CODEWORDS_IN_LINE && cur.isIn() && distance(left, cur.p) < lineLength - colWidth / 2)
+			line.push_back(ReadCodeWord(cur));
+	}
+
+	// both row indicators contain the symbol dimensions and the error correction level, the right one shifted by one
+	// row (see DetectionResultColumn). It is the last codeword of a line, right in front of the stop pattern.
+	BarcodeValue rowCountUpper, rowCountLower, ecLevels, colCounts;
+	auto voteMetadata = [&](CodeWord rowIndicator, bool isLeft) {
+		if (!rowIndicator)
+			return;
+		int value = rowIndicator.code % 30;
+		switch ((Row(rowIndicator) + (isLeft ? 0 : 2)) % 3) {
+		case 0: rowCountUpper.setValue(value * 3 + 1); break;
+		case 1: ecLevels.setValue(value / 3), rowCountLower.setValue(value % 3); break;
+		case 2: colCounts.setValue(value + 1); break;
+		}
+	};
+	for (auto& line : lines) {
+		if (line.empty())
+			continue;
+		voteMetadata(line.front(), true);
+		if (Size(line) > 1)
+			voteMetadata(line.back(), false);
+	}
+	if (rowCountUpper.empty() || rowCountLower.empty() || ecLevels.empty() || colCounts.empty())
+		return DecodeStatus::NotFound;
+	int nRows = rowCountUpper.value()[0] + rowCountLower.value()[0];
+	int nCols = colCounts.value()[0];
+	int ecLevel = ecLevels.value()[0];
+	if (nRows < 3 || nRows > 90 || nCols > 30)
+		return DecodeStatus::NotFound;
+
+	// vote for the codewords of each row, which is identified by the left or else the right row indicator
+	Matrix<BarcodeValue> votes(nCols, nRows);
+	for (auto& line : lines) {
+		int row = -1;
+		for (int i : {0, nCols + 1})
+			if (i < Size(line) && line[i] && Row(line[i]) < nRows) {
+				row = Row(line[i]);
+				break;
+			}
+		if (row == -1)
+			continue;
+		int cluster = (row % 3) * 3;
+		for (int col = 0; col < nCols && col + 1 < Size(line); ++col)
+			if (line[col + 1] && line[col + 1].cluster == cluster)
+				votes(col, row).setValue(line[col + 1].code);
+	}
+
+	std::vector<int> codewords(nRows * nCols, 0);
+	std::vector<int> erasures;
+	for (int row = 0; row < nRows; ++row)
+		for (int col = 0; col < nCols; ++col) {
+			int i = row * nCols + col;
+			int value = votes(col, row).uniqueValue();
+			if (value == -1)
+				erasures.push_back(i);
+			else
+				codewords[i] = value;
+		}
+
+	// the symbol length descriptor can be calculated from the dimensions
+	if (!erasures.empty() && erasures.front() == 0) {
+		codewords[0] = nRows * nCols - (2 << ecLevel);
+		erasures.erase(erasures.begin());
+	}
+
+	return DecodeCodewords(codewords, ecLevel, erasures);
+}
+
+DecodeStatus DoDecode(const BinaryBitmap& image, bool multiple, bool tryRotate, std::list<Result>& results)
+{
+	std::list<Detector::Result> detectorResults;
+	DecodeStatus status = Detector::Detect(image, multiple, tryRotate, detectorResults);
+	if (StatusIsError(status)) {
+		return status;
+	}
+
+	// if a symbol fails to decode, the one found in the next rotation (if any) may still succeed
+	status = DecodeStatus::NotFound;
+	for (const auto& detectorResult : detectorResults) {
+		for (const auto& points : detectorResult.points) {
+			DecoderResult decoderResult = ScanningDecoder::Decode(*detectorResult.bits, points[4], points[5], points[6],
+																  points[7], GetMinCodewordWidth(points),
+																  GetMaxCodewordWidth(points));
+			// the ScanningDecoder assumes (nearly) horizontal rows, DecodeRows reads rows of any inclination
+			if (!decoderResult.isValid())
+				decoderResult = DecodeRows(*detectorResult.bits, points);
+			if (decoderResult.isValid()) {
+				auto point = [&](int i) { return detectorResult.imagePoint(points[i].value()); };
+				Result result(std::move(decoderResult), {point(0), point(2), point(3), point(1)}, BarcodeFormat::PDF417);
+				result.metadata().put(ResultMetadata::ERROR_CORRECTION_LEVEL, decoderResult.ecLevel());
+				if (auto extra = decoderResult.extra()) {
+					result.metadata().put(ResultMetadata::PDF417_EXTRA_METADATA, extra);
+				}
+				results.push_back(result);
+				if (!multiple) {
+					return DecodeStatus::NoError;
+				}
+			}
+			else if (status == DecodeStatus::NotFound) {
+				status = decoderResult.errorCode();
+			}
+		}
+	}
+	return results.empty() ? status : DecodeStatus::NoError;
+}
+
 static Result DecodePure(const BinaryBitmap& image_)
 {
 	auto pimage = image_.getBlackMatrix();
@@ -314,7 +428,7 @@ static Result DecodePure(const BinaryBitmap& image_)
 	return Result(std::move(res), {{left, top}, {right, top}, {right, bottom}, {left, bottom}}, BarcodeFormat::PDF417);
 }
 
-Reader::Reader(const DecodeHints& hints) : _isPure(hints.isPure()) {}
+Reader::Reader(const DecodeHints& hints) : _isPure(hints.isPure()), _tryRotate(hints.tryRotate()) {}
 
 Result
 Reader::decode(const BinaryBitmap& image) const
@@ -328,18 +442,24 @@ Reader::decode(const BinaryBitmap& image) const
 	}
 
 	std::list<Result> results;
-	DecodeStatus status = DoDecode(image, false, results);
+	DecodeStatus status = DoDecode(image, false, _tryRotate, results);
 	if (StatusIsOK(status)) {
 		return results.front();
 	}
 	return Result(status);
 }
 
+bool
+Reader::hasCandidates(const PatternRowSample& sample) const
+{
+	return _isPure || Detector::HasCandidates(sample, _tryRotate);
+}
+
 std::list<Result>
 Reader::decodeMultiple(const BinaryBitmap& image) const
 {
 	std::list<Result> results;
-	DoDecode(image, true, results);
+	DoDecode(image, true, _tryRotate, results);
 	return results;
 }
 
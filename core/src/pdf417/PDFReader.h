@@ -33,11 +33,17 @@ namespace Pdf417 {
 class Reader : public ZXing::Reader
 {
 	bool _isPure;
+	bool _tryRotate;
 
 public:
 	explicit Reader(const DecodeHints& hints);
 
 	Result decode(const BinaryBitmap& image) const override;
+	bool hasCandidates(const PatternRowSample& sample) const override;
+
+	/**
+	* Returns all symbols found in the image, in all orientations.
+	*/
 	std::list<Result> decodeMultiple(const BinaryBitmap& image) const;
 };
 
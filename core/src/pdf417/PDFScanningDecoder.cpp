@@ -27,6 +27,7 @@
 #include "ResultPoint.h"
 #include "ZXNullable.h"
 #include "BitMatrix.h"
+#include "Matrix.h"
 #include "DecodeStatus.h"
 #include "DecoderResult.h"
 #include "ZXTestSupport.h"
@@ -321,12 +322,33 @@ static int GetStartColumn(const DetectionResult& detectionResult, int barcodeCol
 	return leftToRight ? detectionResult.getBoundingBox().value().minX() : detectionResult.getBoundingBox().value().maxX();
 }
 
-static std::vector<std::vector<BarcodeValue>> CreateBarcodeMatrix(DetectionResult& detectionResult)
+/**
+* @return the barcode row number of each image row in the bounding box as read from the row indicator columns, or -1
+* where it is not known or the two row indicator columns disagree.
+*/
+static std::vector<int> GetImageRowNumbers(const DetectionResult& detectionResult, const BoundingBox& boundingBox)
 {
-	std::vector<std::vector<BarcodeValue>> barcodeMatrix(detectionResult.barcodeRowCount());
-	for (auto& row : barcodeMatrix) {
-		row.resize(detectionResult.barcodeColumnCount() + 2);
+	auto rowNumber = [&](int barcodeColumn, int imageRow) {
+		auto& column = detectionResult.column(barcodeColumn);
+		auto codeword = column != nullptr ? column.value().codeword(imageRow) : nullptr;
+		return codeword != nullptr ? codeword.value().rowNumber() : -1;
+	};
+
+	std::vector<int> result;
+	result.reserve(boundingBox.maxY() - boundingBox.minY() + 1);
+	for (int imageRow = boundingBox.minY(); imageRow <= boundingBox.maxY(); imageRow++) {
+		int left = rowNumber(0, imageRow);
+		int right = rowNumber(detectionResult.barcodeColumnCount() + 1, imageRow);
+		result.push_back(left == -1 ? right : (right == -1 || right == left ? left : -1));
 	}
+	return result;
+}
+
+using BarcodeMatrix = Matrix<BarcodeValue>; // one column per barcode column, one row per barcode row
+
+static BarcodeMatrix CreateBarcodeMatrix(DetectionResult& detectionResult)
+{
+	BarcodeMatrix barcodeMatrix(detectionResult.barcodeColumnCount() + 2, detectionResult.barcodeRowCount());
 
 	int column = 0;
 	for (auto& resultColumn : detectionResult.allColumns()) {
@@ -335,11 +357,11 @@ static std::vector<std::vector<BarcodeValue>> CreateBarcodeMatrix(DetectionResul
 				if (codeword != nullptr) {
 					int rowNumber = codeword.value().rowNumber();
 					if (rowNumber >= 0) {
-						if (rowNumber >= Size(barcodeMatrix)) {
+						if (rowNumber >= barcodeMatrix.height()) {
 							// We have more rows than the barcode metadata allows for, ignore them.
 							continue;
 						}
-						barcodeMatrix[rowNumber][column].setValue(codeword.value().value());
+						barcodeMatrix(column, rowNumber).setValue(codeword.value().value());
 					}
 				}
 			}
@@ -354,19 +376,19 @@ static int GetNumberOfECCodeWords(int barcodeECLevel)
 	return 2 << barcodeECLevel;
 }
 
-static bool AdjustCodewordCount(const DetectionResult& detectionResult, std::vector<std::vector<BarcodeValue>>& barcodeMatrix)
+static bool AdjustCodewordCount(const DetectionResult& detectionResult, BarcodeMatrix& barcodeMatrix)
 {
-	auto numberOfCodewords = barcodeMatrix[0][1].value();
+	auto numberOfCodewords = barcodeMatrix(1, 0).value();
 	int calculatedNumberOfCodewords = detectionResult.barcodeColumnCount() * detectionResult.barcodeRowCount() - GetNumberOfECCodeWords(detectionResult.barcodeECLevel());
 	if (numberOfCodewords.empty()) {
 		if (calculatedNumberOfCodewords < 1 || calculatedNumberOfCodewords > CodewordDecoder::MAX_CODEWORDS_IN_BARCODE) {
 			return false;
 		}
-		barcodeMatrix[0][1].setValue(calculatedNumberOfCodewords);
+		barcodeMatrix(1, 0).setValue(calculatedNumberOfCodewords);
 	}
 	else if (numberOfCodewords[0] != calculatedNumberOfCodewords) {
 		// The calculated one is more reliable as it is derived from the row indicator columns
-		barcodeMatrix[0][1].setValue(calculatedNumberOfCodewords);
+		barcodeMatrix(1, 0).setValue(calculatedNumberOfCodewords);
 	}
 	return true;
 }
@@ -664,17 +686,17 @@ static DecoderResult CreateDecoderResult(DetectionResult& detectionResult)
 	std::vector<int> ambiguousIndexesList;
 	for (int row = 0; row < detectionResult.barcodeRowCount(); row++) {
 		for (int column = 0; column < detectionResult.barcodeColumnCount(); column++) {
-			auto values = barcodeMatrix[row][column + 1].value();
+			auto& values = barcodeMatrix(column + 1, row);
 			int codewordIndex = row * detectionResult.barcodeColumnCount() + column;
 			if (values.empty()) {
 				erasures.push_back(codewordIndex);
 			}
-			else if (values.size() == 1) {
-				codewords[codewordIndex] = values[0];
+			else if (int value = values.uniqueValue(); value != -1) {
+				codewords[codewordIndex] = value;
 			}
 			else {
 				ambiguousIndexesList.push_back(codewordIndex);
-				ambiguousIndexValues.push_back(values);
+				ambiguousIndexValues.push_back(values.value());
 			}
 		}
 	}
@@ -721,6 +743,9 @@ ScanningDecoder::Decode(const BitMatrix& image, const Nullable<ResultPoint>& ima
 	detectionResult.setColumn(0, leftRowIndicatorColumn);
 	detectionResult.setColumn(maxBarcodeColumn, rightRowIndicatorColumn);
 
+	auto imageRowNumbers = GetImageRowNumbers(detectionResult, boundingBox);
+	auto rowNumber = [&](int imageRow) { return imageRowNumbers[imageRow - boundingBox.minY()]; };
+
 	bool leftToRight = leftRowIndicatorColumn != nullptr;
 	for (int barcodeColumnCount = 1; barcodeColumnCount <= maxBarcodeColumn; barcodeColumnCount++) {
 		int barcodeColumn = leftToRight ? barcodeColumnCount : maxBarcodeColumn - barcodeColumnCount;
@@ -732,12 +757,11 @@ ScanningDecoder::Decode(const BitMatrix& image, const Nullable<ResultPoint>& ima
 		detectionResult.setColumn(barcodeColumn, DetectionResultColumn(boundingBox, rowIndicator));
 		int startColumn = -1;
 		int previousStartColumn = startColumn;
-		// TODO start at a row for which we know the start position, then detect upwards and downwards from there.
-		for (int imageRow = boundingBox.minY(); imageRow <= boundingBox.maxY(); imageRow++) {
+		auto detectCodeword = [&](int imageRow) -> Nullable<Codeword> {
 			startColumn = GetStartColumn(detectionResult, barcodeColumn, imageRow, leftToRight);
 			if (startColumn < 0 || startColumn > boundingBox.maxX()) {
 				if (previousStartColumn == -1) {
-					continue;
+					return nullptr;
 				}
 				startColumn = previousStartColumn;
 			}
@@ -748,6 +772,35 @@ ScanningDecoder::Decode(const BitMatrix& image, const Nullable<ResultPoint>& ima
 				minCodewordWidth = std::min(minCodewordWidth, codeword.value().width());
 				maxCodewordWidth = std::max(maxCodewordWidth, codeword.value().width());
 			}
+			return codeword;
+		};
+		// TODO start at a row for which we know the start position, then detect upwards and downwards from there.
+		for (int runStart = boundingBox.minY(); runStart <= boundingBox.maxY();) {
+			// find the image rows that belong to the same barcode row according to the row indicator columns
+			int runEnd = runStart + 1;
+			while (rowNumber(runStart) != -1 && runEnd <= boundingBox.maxY() && rowNumber(runEnd) == rowNumber(runStart)) {
+				runEnd++;
+			}
+			int runLength = runEnd - runStart;
+			// A barcode row is usually several image rows high. Look at 3 of them first and only if they do not agree
+			// on the codeword, look at all the others as well.
+			std::array<int, 3> probes = {runStart + runLength / 4, runStart + runLength / 2, runStart + 3 * runLength / 4};
+			bool agree = false;
+			if (runLength > 3) {
+				std::array<Nullable<Codeword>, 3> codewords;
+				for (int i = 0; i < 3; i++) {
+					codewords[i] = detectCodeword(probes[i]);
+				}
+				agree = codewords[0] != nullptr && std::all_of(codewords.begin() + 1, codewords.end(), [&](const Nullable<Codeword>& codeword) {
+					return codeword != nullptr && codeword.value().value() == codewords[0].value().value();
+				});
+			}
+			for (int imageRow = runStart; !agree && imageRow < runEnd; imageRow++) {
+				if (runLength <= 3 || std::find(probes.begin(), probes.end(), imageRow) == probes.end()) {
+					detectCodeword(imageRow);
+				}
+			}
+			runStart = runEnd;
 		}
 	}
 	return CreateDecoderResult(detectionResult);
@@ -97,7 +97,14 @@ ByteArray ReadCodewords(const BitMatrix& bitMatrix, const Version& version, int
 	if (!hasValidDimension(bitMatrix))
 		return {};
 
-	BitMatrix functionPattern = version.buildFunctionPattern();
+	return ReadCodewords(bitMatrix, version, version.buildFunctionPattern(), maskIndex, mirrored);
+}
+
+ByteArray ReadCodewords(const BitMatrix& bitMatrix, const Version& version, const BitMatrix& functionPattern,
+						int maskIndex, bool mirrored)
+{
+	if (!hasValidDimension(bitMatrix) || functionPattern.height() != bitMatrix.height())
+		return {};
 
 	ByteArray result;
 	result.reserve(version.totalCodewords());
@@ -118,7 +125,7 @@ ByteArray ReadCodewords(const BitMatrix& bitMatrix, const Version& version, int
 				// Ignore bits covered by the function pattern
 				if (!functionPattern.get(xx, y)) {
 					// Read a bit
-					AppendBit(currentByte, GetDataMaskBit(maskIndex, xx, y) != getBit(bitMatrix, xx, y, mirrored));
+					AppendBit(currentByte, (maskIndex >= 0 && GetDataMaskBit(maskIndex, xx, y)) != getBit(bitMatrix, xx, y, mirrored));
 					// If we've made a whole byte, save it off
 					if (++bitsRead % 8 == 0)
 						result.push_back(std::exchange(currentByte, 0));
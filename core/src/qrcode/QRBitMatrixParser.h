@@ -45,5 +45,13 @@ FormatInformation ReadFormatInformation(const BitMatrix& bitMatrix, bool mirrore
  */
 ByteArray ReadCodewords(const BitMatrix& bitMatrix, const Version& version, int maskIndex, bool mirrored);
 
+/**
+ * @brief Same as above but with the function pattern of the version passed in, so it can be shared between
+ * several reads of the same symbol (e.g. the normal and the mirrored one). A maskIndex of -1 reads the modules
+ * without unmasking them.
+ */
+ByteArray ReadCodewords(const BitMatrix& bitMatrix, const Version& version, const BitMatrix& functionPattern,
+						int maskIndex, bool mirrored);
+
 } // QRCode
 } // ZXing
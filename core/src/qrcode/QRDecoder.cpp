@@ -30,6 +30,8 @@
 #include "QRDataMask.h"
 #include "QRDecoderMetadata.h"
 #include "QRFormatInformation.h"
+#include "QRSymbolCache.h"
+#include "QRVersion.h"
 #include "ReedSolomonDecoder.h"
 #include "TextDecoder.h"
 #include "ZXContainerAlgorithms.h"
@@ -37,6 +39,7 @@
 
 #include <algorithm>
 #include <list>
+#include <memory>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -49,17 +52,25 @@ namespace ZXing::QRCode {
 *
 * @param codewordBytes data and error correction codewords
 * @param numDataCodewords number of codewords that are data bytes
+* @param uncertain non-zero for each codeword that contains uncertain modules (or empty)
 * @throws ChecksumException if error correction fails
 */
 static bool
-CorrectErrors(ByteArray& codewordBytes, int numDataCodewords)
+CorrectErrors(ByteArray& codewordBytes, int numDataCodewords, const ByteArray& uncertain)
 {
 	// First read into an array of ints
 	std::vector<int> codewordsInts(codewordBytes.begin(), codewordBytes.end());
 
 	int numECCodewords = Size(codewordBytes) - numDataCodewords;
-	if (!ReedSolomonDecode(GenericGF::QRCodeField256(), codewordsInts, numECCodewords))
-		return false;
+	if (!ReedSolomonDecode(GenericGF::QRCodeField256(), codewordsInts, numECCodewords)) {
+		// retry with the uncertain codewords as erasures
+		std::vector<int> erasures;
+		for (int i = 0; i < Size(uncertain); ++i)
+			if (uncertain[i])
+				erasures.push_back(i);
+		if (erasures.empty() || !ReedSolomonDecode(GenericGF::QRCodeField256(), codewordsInts, numECCodewords, erasures))
+			return false;
+	}
 
 	// Copy back into array of bytes -- only need to worry about the bytes that were data
 	// We don't care about errors in the error-correction codewords
@@ -419,14 +430,14 @@ DecodeBitStream(ByteArray&& bytes, const Version& version, ErrorCorrectionLevel
 }
 
 static DecoderResult
-DoDecode(const BitMatrix& bits, const Version& version, const std::string& hintedCharset, bool mirrored)
+DoDecode(const BitMatrix& bits, const Version& version, const BitMatrix& functionPattern,
+		 const FormatInformation& formatInfo, const std::string& hintedCharset, bool mirrored, const BitMatrix* uncertain)
 {
-	auto formatInfo = ReadFormatInformation(bits, mirrored);
 	if (!formatInfo.isValid())
 		return DecodeStatus::FormatError;
 
 	// Read codewords
-	ByteArray codewords = ReadCodewords(bits, version, formatInfo.dataMask(), mirrored);
+	ByteArray codewords = ReadCodewords(bits, version, functionPattern, formatInfo.dataMask(), mirrored);
 	if (codewords.empty())
 		return DecodeStatus::FormatError;
 
@@ -435,6 +446,13 @@ DoDecode(const BitMatrix& bits, const Version& version, const std::string& hinte
 	if (dataBlocks.empty())
 		return DecodeStatus::FormatError;
 
+	// Reading the uncertain modules the same way (without unmasking) gives a non-zero codeword for every codeword
+	// that contains at least one of them, and the same interleaving puts it at the matching position in its block.
+	std::vector<DataBlock> uncertainBlocks;
+	if (uncertain && uncertain->height() == bits.height())
+		uncertainBlocks = DataBlock::GetDataBlocks(ReadCodewords(*uncertain, version, functionPattern, -1, mirrored),
+												   version, formatInfo.errorCorrectionLevel());
+
 	// Count total number of data bytes
 	int totalBytes = 0;
 	for (const auto& dataBlock : dataBlocks) {
@@ -444,12 +462,12 @@ DoDecode(const BitMatrix& bits, const Version& version, const std::string& hinte
 	auto resultIterator = resultBytes.begin();
 
 	// Error-correct and copy data blocks together into a stream of bytes
-	for (auto& dataBlock : dataBlocks)
+	for (int i = 0; i < Size(dataBlocks); ++i)
 	{
-		ByteArray& codewordBytes = dataBlock.codewords();
-		int numDataCodewords = dataBlock.numDataCodewords();
+		ByteArray& codewordBytes = dataBlocks[i].codewords();
+		int numDataCodewords = dataBlocks[i].numDataCodewords();
 
-		if (!CorrectErrors(codewordBytes, numDataCodewords))
+		if (!CorrectErrors(codewordBytes, numDataCodewords, uncertainBlocks.empty() ? ByteArray() : uncertainBlocks[i].codewords()))
 			return DecodeStatus::ChecksumError;
 
 		resultIterator = std::copy_n(codewordBytes.begin(), numDataCodewords, resultIterator);
@@ -459,17 +477,27 @@ DoDecode(const BitMatrix& bits, const Version& version, const std::string& hinte
 	return DecodeBitStream(std::move(resultBytes), version, formatInfo.errorCorrectionLevel(), hintedCharset);
 }
 
-DecoderResult Decode(const BitMatrix& bits, const std::string& hintedCharset)
+static DecoderResult
+DoDecode(const BitMatrix& bits, const Version& version, const BitMatrix& functionPattern, const std::string& hintedCharset,
+		 const BitMatrix* uncertain)
 {
-	const Version* version = ReadVersion(bits);
-	if (!version)
+	// Decide up front whether the symbol is mirrored: the reading of the format information that is closer to
+	// a valid BCH code word wins. Only if both are equally good do we need to try both.
+	auto formatInfo = ReadFormatInformation(bits, false);
+	auto formatInfoMirrored = ReadFormatInformation(bits, true);
+	if (!formatInfo.isValid() && !formatInfoMirrored.isValid())
 		return DecodeStatus::FormatError;
 
-	auto res = DoDecode(bits, *version, hintedCharset, false);
-	if (res.isValid())
+	if (formatInfo.hammingDistance() > formatInfoMirrored.hammingDistance())
+		return DoDecode(bits, version, functionPattern, formatInfoMirrored, hintedCharset, true, uncertain)
+			.setExtra(std::make_shared<DecoderMetadata>(true));
+
+	auto res = DoDecode(bits, version, functionPattern, formatInfo, hintedCharset, false, uncertain);
+	if (res.isValid() || formatInfo.hammingDistance() < formatInfoMirrored.hammingDistance())
 		return res;
 
-	if (auto resMirrored = DoDecode(bits, *version, hintedCharset, true); resMirrored.isValid()) {
+	if (auto resMirrored = DoDecode(bits, version, functionPattern, formatInfoMirrored, hintedCharset, true, uncertain);
+		resMirrored.isValid()) {
 		resMirrored.setExtra(std::make_shared<DecoderMetadata>(true));
 		return resMirrored;
 	}
@@ -477,4 +505,50 @@ DecoderResult Decode(const BitMatrix& bits, const std::string& hintedCharset)
 	return res;
 }
 
+DecoderResult Decode(const BitMatrix& bits, const std::string& hintedCharset, const BitMatrix* uncertain)
+{
+	const Version* version = ReadVersion(bits);
+	if (!version)
+		return DecodeStatus::FormatError;
+
+	// The function pattern only depends on the version and is shared between both orientations.
+	return DoDecode(bits, *version, version->buildFunctionPattern(), hintedCharset, uncertain);
+}
+
+DecoderResult Decode(const BitMatrix& bits, const std::string& hintedCharset, SymbolCache& cache,
+					 const QuadrilateralI& position, const BitMatrix* uncertain)
+{
+	// If we have seen this symbol before, only verify the cached format information in the cached orientation.
+	// This skips reading the version information, building the function pattern and the other orientation.
+	auto cached = cache.find(position, bits.height());
+	if (cached) {
+		if (auto formatInfo = ReadFormatInformation(bits, cached->mirrored); formatInfo == cached->formatInfo) {
+			auto res = DoDecode(bits, *cached->version, *cached->functionPattern, formatInfo, hintedCharset,
+								cached->mirrored, uncertain);
+			if (res.isValid()) {
+				if (cached->mirrored)
+					res.setExtra(std::make_shared<DecoderMetadata>(true));
+				cache.insert(position, std::move(*cached));
+				return res;
+			}
+		}
+	}
+
+	const Version* version = ReadVersion(bits);
+	if (!version)
+		return DecodeStatus::FormatError;
+
+	auto functionPattern = cached && cached->version == version
+							   ? cached->functionPattern
+							   : std::make_shared<const BitMatrix>(version->buildFunctionPattern());
+
+	auto res = DoDecode(bits, *version, *functionPattern, hintedCharset, uncertain);
+	if (res.isValid()) {
+		bool mirrored = res.extra() && static_cast<DecoderMetadata*>(res.extra().get())->isMirrored();
+		cache.insert(position, {{}, 0, version, ReadFormatInformation(bits, mirrored), mirrored, std::move(functionPattern)});
+	}
+
+	return res;
+}
+
 } // namespace ZXing::QRCode
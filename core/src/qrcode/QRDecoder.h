@@ -16,6 +16,8 @@
 * limitations under the License.
 */
 
+#include "Quadrilateral.h"
+
 #include <string>
 
 namespace ZXing {
@@ -25,10 +27,22 @@ class BitMatrix;
 
 namespace QRCode {
 
+class SymbolCache;
+
 /**
  * @brief Decodes a QR Code from the BitMatrix and the hinted charset.
+ *
+ * @param uncertain optional matrix of modules sampled with low confidence, see SampleUncertainModules(). Codewords
+ * containing such modules are treated as erasures if the error correction fails otherwise.
+ */
+DecoderResult Decode(const BitMatrix& bits, const std::string& hintedCharset, const BitMatrix* uncertain = nullptr);
+
+/**
+ * @brief Same as above but looks up the symbol at the given position in the cache first. If found, the cached
+ * version and format information are verified instead of being derived from scratch.
  */
-DecoderResult Decode(const BitMatrix& bits, const std::string& hintedCharset);
+DecoderResult Decode(const BitMatrix& bits, const std::string& hintedCharset, SymbolCache& cache,
+					 const QuadrilateralI& position, const BitMatrix* uncertain = nullptr);
 
 } // QRCode
 } // ZXing
@@ -18,12 +18,14 @@
 
 #include "QRDetector.h"
 
+#include "BinaryBitmap.h"
 #include "BitMatrix.h"
 #include "BitMatrixCursor.h"
 #include "ConcentricFinder.h"
 #include "DetectorResult.h"
 #include "GridSampler.h"
 #include "LogMatrix.h"
+#include "PatternRowSample.h"
 #include "PerspectiveTransform.h"
 #include "QRVersion.h"
 #include "RegressionLine.h"
@@ -43,7 +45,9 @@ constexpr auto PATTERN    = FixedPattern<5, 7>{1, 1, 3, 1, 1};
 constexpr int MIN_MODULES = 1 * 4 + 17; // version 1
 constexpr int MAX_MODULES = 40 * 4 + 17; // version 40
 
-static auto FindFinderPatterns(const BitMatrix& image, bool tryHarder)
+// getRow(y) returns the PatternRow of row y of image
+template <typename GET_ROW>
+static auto FindFinderPatterns(const BitMatrix& image, bool tryHarder, GET_ROW getRow)
 {
 	constexpr int MIN_SKIP         = 3;           // 1 pixel/module times 3 modules/center
 	constexpr int MAX_MODULES_FAST = 20 * 4 + 17; // support up to version 20 for mobile clients
@@ -57,32 +61,9 @@ static auto FindFinderPatterns(const BitMatrix& image, bool tryHarder)
 	if (skip < MIN_SKIP || tryHarder)
 		skip = MIN_SKIP;
 
-	std::vector<ConcentricPattern> res;
-
-	for (int y = skip - 1; y < height; y += skip) {
-		PatternRow row;
-		image.getPatternRow(y, row);
-		PatternView next = row;
-
-		while (next = FindLeftGuard(next, 0, PATTERN, 0.5), next.isValid()) {
-			PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] / 2.0, y + 0.5);
-
-			// make sure p is not 'inside' an already found pattern area
-			if (FindIf(res, [p](const auto& old) { return distance(p, old) < old.size / 2; }) == res.end()) {
-				auto pattern = LocateConcentricPattern(image, PATTERN, p,
-													   Reduce(next) * 3 / 2); // 1.5 for very skewed samples
-				if (pattern) {
-					log(*pattern, 3);
-					res.push_back(*pattern);
-				}
-			}
-
-			next.skipPair();
-			next.skipPair();
-			next.extend();
-		}
-	}
-
+	auto res = FindConcentricPatterns(image, PATTERN, 0.5, false, skip, getRow);
+	for (auto& pattern : res)
+		log(pattern, 3);
 	return res;
 }
 
@@ -317,8 +298,17 @@ static DetectorResult DetectPure(const BitMatrix& image)
 			return {};
 	}
 
-	auto fpWidth = Reduce(diagonal);
-	auto dimension = EstimateDimension(image, tl + fpWidth / 2 * PointF(1, 1), tr + fpWidth / 2 * PointF(-1, 1)).dim;
+	// Generated images typically have an integer module size. The top row of the symbol starts with the 7 module
+	// wide top edge of the top-left finder pattern, which then gives the dimension directly, without tracing the
+	// timing pattern in EstimateDimension. Deflate below also uses integer strides in this case.
+	int dimension = 0;
+	if (int run = BitMatrixCursorI(image, tl, {1, 0}).stepToEdge(1, width); run >= 7 && run % 7 == 0 && width % (run / 7) == 0)
+		dimension = width / (run / 7);
+
+	if (dimension % 4 != 1) {
+		auto fpWidth = Reduce(diagonal);
+		dimension = EstimateDimension(image, tl + fpWidth / 2 * PointF(1, 1), tr + fpWidth / 2 * PointF(-1, 1)).dim;
+	}
 
 	float moduleSize = float(width) / dimension;
 	if (dimension < MIN_MODULES || dimension > MAX_MODULES ||
@@ -339,8 +329,88 @@ static DetectorResult DetectPure(const BitMatrix& image)
 			{{left, top}, {right, top}, {right, bottom}, {left, bottom}}};
 }
 
-DetectorResult Detect(const BitMatrix& image, bool tryHarder, bool isPure)
+/**
+ * @brief Re-locate a finder pattern found in a previous frame in a small window around its old position.
+ *
+ * LocateConcentricPattern succeeds if the start point lies inside the central 3x3 module square. Probing on a grid
+ * with a spacing of 2 modules, ring by ring around the old center, therefore finds a pattern that moved by up to
+ * half its size.
+ */
+static std::optional<ConcentricPattern> RelocateFinderPattern(const BitMatrix& image, const ConcentricPattern& old)
 {
+	int step  = std::max(1, 2 * old.size / 7);
+	int range = old.size / 2;
+	for (int r = 0; r <= range; r += step)
+		for (int dy = -r; dy <= r; dy += step)
+			for (int dx = -r; dx <= r; dx += (std::abs(dy) == r || r == 0) ? step : 2 * r) {
+				auto p = old + PointF(dx, dy);
+				if (!image.isIn(p) || !image.get(p))
+					continue;
+				auto pattern = LocateConcentricPattern(image, PATTERN, p, old.size * 3 / 2);
+				if (pattern && pattern->size * 2 > old.size && pattern->size < old.size * 2) {
+					log(*pattern, 3);
+					return pattern;
+				}
+			}
+	return {};
+}
+
+DetectorResult DetectTracked(const BinaryBitmap& bitmap, bool tryHarder, std::vector<ConcentricPattern>& finderPatterns)
+{
+	auto binImg = bitmap.getBlackMatrix();
+	if (binImg == nullptr)
+		return {};
+	auto& image = *binImg;
+
+#ifdef PRINT_DEBUG
+	LogMatrixWriter lmw(log, image, 5, "qr-log.pnm");
+#endif
+
+	if (Size(finderPatterns) == 3) {
+		std::vector<ConcentricPattern> relocated;
+		for (const auto& old : finderPatterns)
+			if (auto pattern = RelocateFinderPattern(image, old))
+				relocated.push_back(*pattern);
+			else
+				break;
+
+		if (Size(relocated) == 3) {
+			auto sets = GenerateFinderPatternSets(std::move(relocated));
+			if (!sets.empty()) {
+				if (auto res = SampleAtFinderPatternSet(image, sets[0]); res.isValid()) {
+					finderPatterns = {sets[0].tl, sets[0].tr, sets[0].bl};
+					return res;
+				}
+			}
+		}
+	}
+
+	// lost track (or first frame) -> full scan
+	finderPatterns.clear();
+
+	auto getRow = [&bitmap](int y) -> const PatternRow& { return bitmap.getBlackPatternRow(y); };
+	auto sets = GenerateFinderPatternSets(FindFinderPatterns(image, tryHarder, getRow));
+	if (sets.empty())
+		return {};
+
+	auto res = SampleAtFinderPatternSet(image, sets[0]);
+	if (res.isValid())
+		finderPatterns = {sets[0].tl, sets[0].tr, sets[0].bl};
+	return res;
+}
+
+bool HasFinderPattern(const PatternRowSample& sample)
+{
+	return ContainsCrossedPattern(sample, 0.5, false, PATTERN);
+}
+
+DetectorResult Detect(const BinaryBitmap& bitmap, bool tryHarder, bool isPure)
+{
+	auto binImg = bitmap.getBlackMatrix();
+	if (binImg == nullptr)
+		return {};
+	auto& image = *binImg;
+
 #ifdef PRINT_DEBUG
 	LogMatrixWriter lmw(log, image, 5, "qr-log.pnm");
 #endif
@@ -348,7 +418,9 @@ DetectorResult Detect(const BitMatrix& image, bool tryHarder, bool isPure)
 	if (isPure)
 		return DetectPure(image);
 
-	auto sets = GenerateFinderPatternSets(FindFinderPatterns(image, tryHarder));
+	// the rows are cached in the bitmap and shared with the other readers
+	auto getRow = [&bitmap](int y) -> const PatternRow& { return bitmap.getBlackPatternRow(y); };
+	auto sets = GenerateFinderPatternSets(FindFinderPatterns(image, tryHarder, getRow));
 
 	if (sets.empty())
 		return {};
@@ -16,17 +16,38 @@
 * limitations under the License.
 */
 
+#include <vector>
+
 namespace ZXing {
 
 class DetectorResult;
+class BinaryBitmap;
 class BitMatrix;
+class PatternRowSample;
+struct ConcentricPattern;
 
 namespace QRCode {
 
 /**
  * @brief Detects a QR Code in an image.
  */
-DetectorResult Detect(const BitMatrix& image, bool tryHarder, bool isPure);
+DetectorResult Detect(const BinaryBitmap& image, bool tryHarder, bool isPure);
+
+/**
+ * @brief Checks whether a sampled row and a sampled column cross something that looks like a finder pattern at about
+ * the same spot.
+ */
+bool HasFinderPattern(const PatternRowSample& sample);
+
+/**
+ * @brief Detects a QR Code in a sequence of images, e.g. subsequent video frames.
+ *
+ * The finder patterns of the symbol detected in the previous frame are re-located in small windows around their
+ * old positions. Only if that fails, the whole image is scanned, using the pattern rows cached in the bitmap.
+ * @param finderPatterns in: finder patterns from the previous call (or empty), out: finder patterns of the detected
+ * symbol or empty if none was found. Callers should clear it if the sampled symbol fails to decode.
+ */
+DetectorResult DetectTracked(const BinaryBitmap& bitmap, bool tryHarder, std::vector<ConcentricPattern>& finderPatterns);
 
 } // QRCode
 } // ZXing
@@ -63,12 +63,13 @@ static const std::array<int, 2> FORMAT_INFO_DECODE_LOOKUP[] = {
 	{0x2BED, 0x1F},
 };
 
-FormatInformation::FormatInformation(int formatInfo)
+FormatInformation::FormatInformation(int formatInfo, int hammingDistance)
 {
 	// Bits 3,4
 	_errorCorrectionLevel = ECLevelFromBits((formatInfo >> 3) & 0x03);
 	// Bottom 3 bits
 	_dataMask = static_cast<uint8_t>(formatInfo & 0x07);
+	_hammingDistance = static_cast<uint8_t>(hammingDistance);
 }
 
 /**
@@ -97,7 +98,7 @@ FormatInformation::DecodeFormatInformation(uint32_t formatInfoBits1, uint32_t fo
 	// Hamming distance of the 32 masked codes is 7, by construction, so <= 3 bits
 	// differing means we found a match
 	if (bestDifference <= 3)
-		return {bestFormatInfo};
+		return {bestFormatInfo, bestDifference};
 
 	return {};
 }
@@ -46,6 +46,14 @@ public:
 		return _dataMask;
 	}
 
+	/**
+	* @return number of bits that differed between the read format info bits and the closest valid code word,
+	* i.e. 0 for a perfect read and at most 3 for a valid one.
+	*/
+	int hammingDistance() const {
+		return _hammingDistance;
+	}
+
 	bool isValid() const { return _errorCorrectionLevel != ErrorCorrectionLevel::Invalid; }
 
 	bool operator==(const FormatInformation& other) const {
@@ -55,8 +63,9 @@ public:
 private:
 	ErrorCorrectionLevel _errorCorrectionLevel = ErrorCorrectionLevel::Invalid;
 	uint8_t _dataMask = 0;
+	uint8_t _hammingDistance = 255;
 
-	FormatInformation(int formatInfo);
+	FormatInformation(int formatInfo, int hammingDistance);
 };
 
 } // QRCode
@@ -19,43 +19,85 @@
 
 #include "BinaryBitmap.h"
 #include "BitMatrix.h"
+#include "ConcentricFinder.h"
 #include "DecodeHints.h"
 #include "DecoderResult.h"
 #include "DetectorResult.h"
+#include "GridSampler.h"
 #include "QRDecoder.h"
 #include "QRDecoderMetadata.h"
 #include "QRDetector.h"
+#include "QRSymbolCache.h"
 #include "Result.h"
 #include "ResultPoint.h"
 
+#include <mutex>
 #include <utility>
+#include <vector>
 
 namespace ZXing::QRCode {
 
+// The finder patterns of the symbol found in the previous image
+struct Reader::Tracker
+{
+	std::mutex mutex;
+	std::vector<ConcentricPattern> finderPatterns;
+};
+
 Reader::Reader(const DecodeHints& hints)
 	: _tryHarder(hints.tryHarder()), _isPure(hints.isPure()), _charset(hints.characterSet())
 {
+	if (hints.trackSymbols()) {
+		_symbolCache = std::make_shared<SymbolCache>();
+		if (!_isPure)
+			_tracker = std::make_unique<Tracker>();
+	}
 }
 
+Reader::~Reader() = default;
+
 Result
 Reader::decode(const BinaryBitmap& image) const
 {
-	auto binImg = image.getBlackMatrix();
-	if (binImg == nullptr) {
-		return Result(DecodeStatus::NotFound);
+	DetectorResult detectorResult;
+	if (_tracker) {
+		std::lock_guard<std::mutex> lock(_tracker->mutex);
+		detectorResult = DetectTracked(image, _tryHarder, _tracker->finderPatterns);
+	} else {
+		detectorResult = Detect(image, _tryHarder, _isPure);
 	}
-
-	auto detectorResult = Detect(*binImg, _tryHarder, _isPure);
 	if (!detectorResult.isValid())
 		return Result(DecodeStatus::NotFound);
 
-	auto decoderResult = Decode(detectorResult.bits(), _charset);
+	auto decode = [&](const BitMatrix* uncertain) {
+		return _symbolCache ? Decode(detectorResult.bits(), _charset, *_symbolCache, detectorResult.position(), uncertain)
+							: Decode(detectorResult.bits(), _charset, uncertain);
+	};
+
+	auto decoderResult = decode(nullptr);
+	// only if the error correction failed, retry with the modules sampled with low confidence as erasures
+	if (decoderResult.errorCode() == DecodeStatus::ChecksumError)
+		if (auto uncertain = SampleUncertainModules(*image.getBlackMatrix(), detectorResult); !uncertain.empty())
+			decoderResult = decode(&uncertain);
+
 	auto position = detectorResult.position();
 
+	// don't look for a symbol that could not be decoded again in the next image
+	if (_tracker && !decoderResult.isValid()) {
+		std::lock_guard<std::mutex> lock(_tracker->mutex);
+		_tracker->finderPatterns.clear();
+	}
+
 	// TODO: report the information that the symbol was mirrored back to the caller
 	//bool isMirrored = decoderResult.extra() && static_cast<DecoderMetadata*>(decoderResult.extra().get())->isMirrored();
 
 	return Result(std::move(decoderResult), std::move(position), BarcodeFormat::QRCode);
 }
 
+bool
+Reader::hasCandidates(const PatternRowSample& sample) const
+{
+	return _isPure || HasFinderPattern(sample);
+}
+
 } // namespace ZXing::QRCode
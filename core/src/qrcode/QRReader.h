@@ -18,6 +18,7 @@
 
 #include "Reader.h"
 
+#include <memory>
 #include <string>
 
 namespace ZXing {
@@ -26,6 +27,8 @@ class DecodeHints;
 
 namespace QRCode {
 
+class SymbolCache;
+
 /**
 * This implementation can detect and decode QR Codes in an image.
 *
@@ -35,11 +38,26 @@ class Reader : public ZXing::Reader
 {
 public:
 	explicit Reader(const DecodeHints& hints);
+	~Reader() override;
+
 	Result decode(const BinaryBitmap& image) const override;
+	bool hasCandidates(const PatternRowSample& sample) const override;
+
+	/**
+	 * Optionally remember the version and format information of decoded symbols, to speed up decoding the same
+	 * symbol in subsequent images (e.g. video frames). The cache may be shared between readers. A reader constructed
+	 * with DecodeHints::trackSymbols() set creates its own cache.
+	 */
+	void setSymbolCache(std::shared_ptr<SymbolCache> cache) { _symbolCache = std::move(cache); }
+	const std::shared_ptr<SymbolCache>& symbolCache() const { return _symbolCache; }
 
 private:
+	struct Tracker;
+
 	bool _tryHarder, _isPure;
 	std::string _charset;
+	std::shared_ptr<SymbolCache> _symbolCache;
+	std::unique_ptr<Tracker> _tracker; // see DecodeHints::trackSymbols()
 };
 
 } // QRCode
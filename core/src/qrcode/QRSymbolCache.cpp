@@ -0,0 +1,87 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "QRSymbolCache.h"
+
+#include "QRVersion.h"
+#include "ZXContainerAlgorithms.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace ZXing::QRCode {
+
+PointF SymbolCache::Center(const QuadrilateralI& position)
+{
+	return PointF(position[0] + position[1] + position[2] + position[3]) / 4;
+}
+
+double SymbolCache::ModuleSize(const QuadrilateralI& position, int dimension)
+{
+	return (distance(position.topLeft(), position.topRight()) + distance(position.topLeft(), position.bottomLeft())) /
+		   (2 * dimension);
+}
+
+// The same physical symbol in a subsequent frame has about the same size and did not move by more than a quarter of
+// its size. Anything else that matches by accident will fail the verification in the decoder.
+static bool IsSameSymbol(const SymbolCache::Entry& e, PointF center, double moduleSize, int dimension)
+{
+	return e.version->dimensionForVersion() == dimension && moduleSize > e.moduleSize * 0.8 &&
+		   moduleSize < e.moduleSize * 1.25 && distance(center, e.center) < dimension * e.moduleSize / 4;
+}
+
+std::optional<SymbolCache::Entry> SymbolCache::find(const QuadrilateralI& position, int dimension) const
+{
+	auto center = Center(position);
+	auto moduleSize = ModuleSize(position, dimension);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto i = FindIf(_items, [&](const Item& item) { return IsSameSymbol(item.entry, center, moduleSize, dimension); });
+	if (i == _items.end())
+		return std::nullopt;
+
+	i->lastUse = ++_useCount;
+	return i->entry;
+}
+
+void SymbolCache::insert(const QuadrilateralI& position, Entry entry)
+{
+	if (!entry.version || _capacity <= 0)
+		return;
+
+	int dimension = entry.version->dimensionForVersion();
+	entry.center = Center(position);
+	entry.moduleSize = ModuleSize(position, dimension);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto i = FindIf(_items, [&](const Item& item) { return IsSameSymbol(item.entry, entry.center, entry.moduleSize, dimension); });
+	if (i == _items.end()) {
+		if (Size(_items) < _capacity)
+			i = _items.insert(_items.end(), Item{});
+		else
+			i = std::min_element(_items.begin(), _items.end(),
+								 [](const Item& a, const Item& b) { return a.lastUse < b.lastUse; });
+	}
+	*i = {std::move(entry), ++_useCount};
+}
+
+void SymbolCache::clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_items.clear();
+}
+
+} // namespace ZXing::QRCode
@@ -0,0 +1,83 @@
+#pragma once
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BitMatrix.h"
+#include "Quadrilateral.h"
+#include "QRFormatInformation.h"
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace ZXing {
+namespace QRCode {
+
+class Version;
+
+/**
+* Remembers the version, format information and orientation of recently decoded QR Codes, keyed by their approximate
+* position and module size in the image. When the same physical symbol is decoded again (e.g. in the next video
+* frame), the decoder only needs to verify the cached values instead of deriving them from scratch.
+*
+* The cache is thread-safe and can be shared between several Reader instances.
+*/
+class SymbolCache
+{
+public:
+	struct Entry
+	{
+		PointF center;
+		double moduleSize = 0;
+		const Version* version = nullptr;
+		FormatInformation formatInfo;
+		bool mirrored = false;
+		std::shared_ptr<const BitMatrix> functionPattern;
+	};
+
+	explicit SymbolCache(int capacity = 8) : _capacity(capacity) {}
+
+	/**
+	 * @brief Look up a symbol with given dimension (in modules) at the given position (in pixels).
+	 */
+	std::optional<Entry> find(const QuadrilateralI& position, int dimension) const;
+
+	/**
+	 * @brief Store (or refresh) the entry for a successfully decoded symbol, evicting the least recently used one.
+	 */
+	void insert(const QuadrilateralI& position, Entry entry);
+
+	void clear();
+
+	static PointF Center(const QuadrilateralI& position);
+	static double ModuleSize(const QuadrilateralI& position, int dimension);
+
+private:
+	struct Item
+	{
+		Entry entry;
+		mutable long lastUse;
+	};
+
+	mutable std::mutex _mutex;
+	std::vector<Item> _items;
+	int _capacity;
+	mutable long _useCount = 0;
+};
+
+} // QRCode
+} // ZXing
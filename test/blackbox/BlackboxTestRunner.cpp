@@ -282,18 +282,18 @@ int runBlackBoxTests(const fs::path& testPathPrefix, const std::set<std::string>
 
 		// clang-format off
 		runTests("aztec-1", "Aztec", 16, {
-			{ 15, 15, 0   },
-			{ 15, 15, 90  },
-			{ 15, 15, 180 },
-			{ 15, 15, 270 },
+			{ 16, 16, 0   },
+			{ 16, 16, 90  },
+			{ 16, 16, 180 },
+			{ 16, 16, 270 },
 			{ 16, 0, pure },
 		});
 
 		runTests("aztec-2", "Aztec", 22, {
-			{ 5, 5, 0   },
-			{ 4, 4, 90  },
-			{ 6, 6, 180 },
-			{ 3, 3, 270 },
+			{ 6, 6, 0   },
+			{ 6, 6, 90  },
+			{ 7, 7, 180 },
+			{ 4, 4, 270 },
 		});
 
 		runTests("datamatrix-1", "DataMatrix", 22, {
@@ -404,11 +404,11 @@ int runBlackBoxTests(const fs::path& testPathPrefix, const std::set<std::string>
 		});
 
 		runTests("maxicode-1", "MaxiCode", 6, {
-			{ 1, 1, 5, 5, 0 },
+			{ 6, 6, 0 },
 		});
 
 		runTests("maxicode-2", "MaxiCode", 4, {
-			{ 0, 0, 0 },
+			{ 1, 1, 0 },
 		});
 
 		runTests("upca-1", "UPC-A", 12, {
@@ -540,19 +540,25 @@ int runBlackBoxTests(const fs::path& testPathPrefix, const std::set<std::string>
 		});
 
 		runTests("pdf417-1", "PDF417", 15, {
-			{ 14, 14, 0   },
-			{ 14, 14, 180 },
+			{ 14, 15, 0   },
+			{ 14, 15, 180 },
+			{ 1, 15, 90  },
+			{ 1, 15, 270 },
 			{ 15, 0, pure },
 		});
 
 		runTests("pdf417-2", "PDF417", 25, {
 			{ 25, 25, 0   },
 			{ 25, 25, 180 },
+			{ 0, 25, 90  },
+			{ 0, 25, 270 },
 		});
 
 		runTests("pdf417-3", "PDF417", 16, {
 			{ 16, 16, 0   },
 			{ 16, 16, 180 },
+			{ 0, 16, 90  },
+			{ 0, 16, 270 },
 			{ 7, 0, pure },
 		});
 
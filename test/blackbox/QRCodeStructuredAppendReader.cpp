@@ -20,45 +20,28 @@
 #include "DecodeHints.h"
 #include "ImageLoader.h"
 #include "Result.h"
+#include "StructuredAppendAssembler.h"
 #include "TextUtfEncoding.h"
 #include "qrcode/QRReader.h"
 
-#include <list>
 #include <string>
-#include <utility>
 
 namespace ZXing::Test {
 
 Result QRCodeStructuredAppendReader::readMultiple(const std::vector<fs::path>& imgPaths, int rotation)
 {
 	QRCode::Reader reader({});
-	std::list<Result> allResults;
-	int prevParity = -1;
+	StructuredAppendAssembler assembler(1, Size(imgPaths));
 	for (const auto& imgPath : imgPaths) {
 		auto r = reader.decode(*ImageLoader::load(imgPath).rotated(rotation));
 		if (r.metadata().getInt(ResultMetadata::STRUCTURED_APPEND_CODE_COUNT, 0) != Size(imgPaths))
 			return Result(DecodeStatus::FormatError);
-		auto parity = r.metadata().getInt(ResultMetadata::STRUCTURED_APPEND_PARITY, -1);
-		if (prevParity != -1 && prevParity != parity)
-			return Result(DecodeStatus::FormatError);
-		prevParity = parity;
-		allResults.push_back(r);
+		if (auto merged = assembler.add(r); merged.isValid())
+			return {std::wstring(merged.text()), {}, BarcodeFormat::QRCode};
+		assembler.nextFrame();
 	}
 
-	if (allResults.empty())
-		return Result(DecodeStatus::NotFound);
-
-	allResults.sort([](const Result &r1, const Result &r2) {
-		auto s1 = r1.metadata().getInt(ResultMetadata::STRUCTURED_APPEND_SEQUENCE, -1);
-		auto s2 = r2.metadata().getInt(ResultMetadata::STRUCTURED_APPEND_SEQUENCE, -1);
-		return s1 < s2;
-	});
-
-	std::wstring text;
-	for (const auto& r : allResults)
-		text.append(r.text());
-
-	return {std::move(text), {}, BarcodeFormat::QRCode};
+	return Result(DecodeStatus::NotFound);
 }
 
 } // ZXing::Test
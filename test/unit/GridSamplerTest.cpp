@@ -0,0 +1,82 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BitMatrix.h"
+#include "GridSampler.h"
+#include "SymbolDrawing.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+
+namespace {
+	constexpr int N = 8;	  // modules per side
+	constexpr int MODULE = 4; // pixels per module
+	constexpr int MARGIN = 2; // pixels around the grid
+
+	BitMatrix Checkerboard()
+	{
+		BitMatrix symbol(N, N);
+		for (int y = 0; y < N; ++y)
+			for (int x = 0; x < N; ++x)
+				if ((x + y) % 2)
+					symbol.set(x, y);
+		return symbol;
+	}
+
+	QuadrilateralF GridPosition()
+	{
+		return {PointF(MARGIN, MARGIN), {MARGIN + N * MODULE, MARGIN}, {MARGIN + N * MODULE, MARGIN + N * MODULE},
+				{MARGIN, MARGIN + N * MODULE}};
+	}
+
+	DetectorResult Sample(const BitMatrix& image)
+	{
+		return SampleGrid(image, N, N, PerspectiveTransform(Rectangle<PointF>(N, N), GridPosition()));
+	}
+}
+
+TEST(GridSamplerTest, NoUncertainModules)
+{
+	BitMatrix image(N * MODULE + 2 * MARGIN, N * MODULE + 2 * MARGIN);
+	Utility::DrawSymbol(image, Checkerboard(), GridPosition());
+
+	auto grid = Sample(image);
+	EXPECT_EQ(grid.bits(), Checkerboard());
+	EXPECT_TRUE(SampleUncertainModules(image, grid).empty());
+}
+
+TEST(GridSamplerTest, ModuleNearBoundary)
+{
+	BitMatrix image(N * MODULE + 2 * MARGIN, N * MODULE + 2 * MARGIN);
+	Utility::DrawSymbol(image, Checkerboard(), GridPosition());
+
+	// let the right neighbour of module (3, 4) bleed one pixel into it: the module center is still sampled correctly
+	// but the probe a quarter module to its right now lands on the other color
+	const int x = MARGIN + 4 * MODULE - 1;
+	for (int y = MARGIN + 4 * MODULE; y < MARGIN + 5 * MODULE; ++y)
+		image.flip(x, y);
+
+	auto grid = Sample(image);
+	EXPECT_EQ(grid.bits(), Checkerboard());
+
+	auto uncertain = SampleUncertainModules(image, grid);
+	ASSERT_EQ(uncertain.width(), N);
+	ASSERT_EQ(uncertain.height(), N);
+	for (int y = 0; y < N; ++y)
+		for (int x = 0; x < N; ++x)
+			EXPECT_EQ(uncertain.get(x, y), x == 3 && y == 4) << "module " << x << ", " << y;
+}
@@ -21,6 +21,7 @@
 #include "ReedSolomonEncoder.h"
 
 #include <algorithm>
+#include <numeric>
 #include <ostream>
 
 static std::ostream& operator<<(std::ostream& out, const ZXing::GenericGF& field) {
@@ -123,6 +124,36 @@ namespace {
 		}
 	}
 
+	void TestErasures(const GenericGF& field, int dataSize, int ecSize, int erasureStep, PseudoRandom& random) {
+		std::vector<int> encoded(dataSize + ecSize);
+		for (int i = 0; i < dataSize; ++i)
+			encoded[i] = random.next(0, field.size() - 1);
+		ReedSolomonEncode(field, encoded, ecSize);
+
+		// test every erasureStep-th number of erasures and the last few ones
+		for (int numErasures = 0; numErasures <= ecSize;
+			 numErasures += numErasures + erasureStep < ecSize - 1 ? erasureStep : 1) {
+			int numErrors = (ecSize - numErasures) / 2;
+			// the erasures are the first positions of a random permutation, the errors the following ones
+			std::vector<int> positions(Size(encoded));
+			std::iota(positions.begin(), positions.end(), 0);
+			for (int i = Size(positions) - 1; i > 0; --i)
+				std::swap(positions[i], positions[random.next(0, i)]);
+
+			auto message = encoded;
+			std::vector<int> erasures(positions.begin(), positions.begin() + numErasures);
+			// every other erasure is a correct codeword, which must not hurt
+			for (int i = 0; i < numErasures; i += 2)
+				message[erasures[i]] ^= random.next(1, field.size() - 1);
+			for (int i = numErasures; i < numErasures + numErrors; ++i)
+				message[positions[i]] ^= random.next(1, field.size() - 1);
+
+			EXPECT_TRUE(ReedSolomonDecode(field, message, ecSize, erasures))
+				<< field << " erasures: " << numErasures << ", errors: " << numErrors;
+			EXPECT_EQ(message, encoded) << field << " erasures: " << numErasures << ", errors: " << numErrors;
+		}
+	}
+
 }
 
 TEST(ReedSolomonTest, DataMatrix)
@@ -480,3 +511,35 @@ TEST(ReedSolomonTest, Aztec)
 	TestEncodeDecodeRandom(GenericGF::AztecData10(), 768, 255);
 	TestEncodeDecodeRandom(GenericGF::AztecData12(), 3072, 1023);
 }
+
+TEST(ReedSolomonTest, Syndromes)
+{
+	PseudoRandom random(0xDEADBEEF);
+	for (const GenericGF* field : {&GenericGF::QRCodeField256(), &GenericGF::DataMatrixField256()}) {
+		for (int n : {1, 15, 16, 17, 100, 255}) {
+			std::vector<int> message(n);
+			for (int& c : message)
+				c = random.next(0, 255);
+			int numSyndromes = std::min(n, 68);
+			std::vector<int> syndromes(numSyndromes);
+			if (!field->computeSyndromes(message.data(), n, syndromes.data(), numSyndromes))
+				GTEST_SKIP() << "no SIMD syndrome kernel available";
+			GenericGFPoly poly(*field, std::vector<int>(message));
+			for (int j = 0; j < numSyndromes; ++j)
+				EXPECT_EQ(syndromes[j], poly.evaluateAt(field->exp(j + field->generatorBase())))
+					<< *field << " n=" << n << " j=" << j;
+		}
+	}
+}
+
+TEST(ReedSolomonTest, Erasures)
+{
+	PseudoRandom random(0x12345678);
+	for (const GenericGF* field : {&GenericGF::QRCodeField256(), &GenericGF::DataMatrixField256(),
+								   &GenericGF::AztecData6(), &GenericGF::MaxiCodeField64()})
+		TestErasures(*field, 20, 16, 1, random);
+
+	// more than 256 error-correction codewords are handled by the Euclidean decoder
+	TestErasures(GenericGF::AztecData12(), 600, 300, 23, random);
+	TestErasures(GenericGF::AztecData12(), 600, 301, 23, random);
+}
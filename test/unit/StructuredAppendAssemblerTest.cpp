@@ -0,0 +1,81 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "StructuredAppendAssembler.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+
+static Result MakePart(std::wstring text, int seq, int count, int parity)
+{
+	Result res(std::move(text), {}, BarcodeFormat::QRCode);
+	res.metadata().put(ResultMetadata::STRUCTURED_APPEND_SEQUENCE, seq);
+	res.metadata().put(ResultMetadata::STRUCTURED_APPEND_CODE_COUNT, count);
+	res.metadata().put(ResultMetadata::STRUCTURED_APPEND_PARITY, parity);
+	return res;
+}
+
+TEST(StructuredAppendAssemblerTest, MergeOutOfOrder)
+{
+	StructuredAppendAssembler assembler;
+	EXPECT_FALSE(assembler.add(MakePart(L"C", 2, 3, 42)).isValid());
+	EXPECT_FALSE(assembler.add(MakePart(L"A", 0, 3, 42)).isValid());
+	// duplicates are ignored
+	EXPECT_FALSE(assembler.add(MakePart(L"A", 0, 3, 42)).isValid());
+	EXPECT_EQ(assembler.pendingSets(), 1);
+
+	auto res = assembler.add(MakePart(L"B", 1, 3, 42));
+	EXPECT_TRUE(res.isValid());
+	EXPECT_EQ(res.text(), L"ABC");
+	EXPECT_EQ(res.format(), BarcodeFormat::QRCode);
+	EXPECT_EQ(res.metadata().getInt(ResultMetadata::STRUCTURED_APPEND_PARITY), 42);
+	EXPECT_EQ(assembler.pendingSets(), 0);
+}
+
+TEST(StructuredAppendAssemblerTest, SeparateSetsByParity)
+{
+	StructuredAppendAssembler assembler;
+	EXPECT_FALSE(assembler.add(MakePart(L"A", 0, 2, 1)).isValid());
+	EXPECT_FALSE(assembler.add(MakePart(L"X", 0, 2, 2)).isValid());
+	EXPECT_EQ(assembler.pendingSets(), 2);
+	EXPECT_EQ(assembler.add(MakePart(L"Y", 1, 2, 2)).text(), L"XY");
+	EXPECT_EQ(assembler.add(MakePart(L"B", 1, 2, 1)).text(), L"AB");
+}
+
+TEST(StructuredAppendAssemblerTest, PassThroughSingle)
+{
+	StructuredAppendAssembler assembler;
+	auto res = assembler.add(Result(L"single", {}, BarcodeFormat::QRCode));
+	EXPECT_TRUE(res.isValid());
+	EXPECT_EQ(res.text(), L"single");
+	EXPECT_EQ(assembler.pendingSets(), 0);
+}
+
+TEST(StructuredAppendAssemblerTest, Expiry)
+{
+	StructuredAppendAssembler assembler(2, 1);
+	assembler.add(MakePart(L"A", 0, 2, 1));
+	assembler.nextFrame();
+	assembler.add(MakePart(L"X", 0, 2, 2));
+	assembler.add(MakePart(L"U", 0, 2, 3)); // evicts the least recently updated set (parity 1)
+	EXPECT_EQ(assembler.pendingSets(), 2);
+	EXPECT_FALSE(assembler.add(MakePart(L"B", 1, 2, 1)).isValid());
+
+	assembler.nextFrame();
+	assembler.nextFrame();
+	EXPECT_EQ(assembler.pendingSets(), 0);
+}
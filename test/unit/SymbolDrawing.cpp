@@ -0,0 +1,71 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "SymbolDrawing.h"
+
+#include "BitMatrix.h"
+#include "PerspectiveTransform.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ZXing { namespace Utility {
+
+void DrawSymbol(BitMatrix& image, const BitMatrix& symbol, const QuadrilateralF& position)
+{
+	// map the pixel centers back into the module grid of the symbol
+	auto pix2Mod = PerspectiveTransform(position, Rectangle<PointF>(symbol.width(), symbol.height()));
+
+	auto [minX, maxX] = std::minmax({position[0].x, position[1].x, position[2].x, position[3].x});
+	auto [minY, maxY] = std::minmax({position[0].y, position[1].y, position[2].y, position[3].y});
+
+	for (int y = std::max(0, int(minY)); y < std::min(image.height(), int(std::ceil(maxY))); ++y)
+		for (int x = std::max(0, int(minX)); x < std::min(image.width(), int(std::ceil(maxX))); ++x) {
+			auto m = pix2Mod(PointF(x + 0.5, y + 0.5));
+			if (m.x >= 0 && m.x < symbol.width() && m.y >= 0 && m.y < symbol.height() && symbol.get(PointI(m)))
+				image.set(x, y);
+		}
+}
+
+void DrawSymbol(BitMatrix& image, const BitMatrix& symbol, PointF center, double moduleSize, double angle)
+{
+	auto a = angle * 3.14159265358979323846 / 180;
+	auto dx = moduleSize * symbol.width() / 2 * PointF(std::cos(a), std::sin(a));
+	auto dy = moduleSize * symbol.height() / 2 * PointF(-std::sin(a), std::cos(a));
+	DrawSymbol(image, symbol, {center - dx - dy, center + dx - dy, center + dx + dy, center - dx + dy});
+}
+
+BitMatrix DrawSymbols(const std::vector<BitMatrix>& symbols, int width, int height, double moduleSize, double angle)
+{
+	constexpr int COLS = 3;
+	const int rows = (int(symbols.size()) + COLS - 1) / COLS;
+	BitMatrix image(width, height);
+	for (int i = 0; i < int(symbols.size()); ++i)
+		DrawSymbol(image, symbols[i],
+				   {(i % COLS + 0.5) * width / COLS, (i / COLS + 0.5) * height / std::max(1, rows)}, moduleSize, angle);
+	return image;
+}
+
+BitMatrix RepeatRow(const BitMatrix& image, int y)
+{
+	BitMatrix res(image.width(), image.height());
+	for (int x = 0; x < image.width(); ++x)
+		if (image.get(x, y))
+			res.setRegion(x, 0, 1, image.height());
+	return res;
+}
+
+}} // ZXing::Utility
@@ -0,0 +1,60 @@
+#pragma once
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BinaryBitmap.h"
+#include "BitMatrix.h"
+#include "Point.h"
+#include "Quadrilateral.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ZXing { namespace Utility {
+
+	/// Draws the symbol (one bit per module) into image with its 4 corners (tl, tr, br, bl) at the given position.
+	void DrawSymbol(BitMatrix& image, const BitMatrix& symbol, const QuadrilateralF& position);
+
+	/// Draws the symbol centered at center, moduleSize pixels per module, rotated clockwise by angle degrees.
+	void DrawSymbol(BitMatrix& image, const BitMatrix& symbol, PointF center, double moduleSize, double angle = 0);
+
+	/// Draws the symbols into a new image of the given size, each one centered in a cell of a 3 column grid.
+	BitMatrix DrawSymbols(const std::vector<BitMatrix>& symbols, int width, int height, double moduleSize,
+						  double angle = 0);
+
+	/// Copies row y of image into all of its rows, i.e. the patterns of that row show up in every row but in no column.
+	BitMatrix RepeatRow(const BitMatrix& image, int y);
+
+	/// A BinaryBitmap showing a (drawn) BitMatrix, for the detectors that read the cached rows of a bitmap.
+	class BitMatrixBitmap : public BinaryBitmap
+	{
+		std::shared_ptr<const BitMatrix> _bits;
+
+	public:
+		explicit BitMatrixBitmap(BitMatrix&& bits) : _bits(std::make_shared<const BitMatrix>(std::move(bits))) {}
+
+		int width() const override { return _bits->width(); }
+		int height() const override { return _bits->height(); }
+		bool getPatternRow(int y, PatternRow& res) const override
+		{
+			_bits->getPatternRow(y, res);
+			return true;
+		}
+		std::shared_ptr<const BitMatrix> getBlackMatrix() const override { return _bits; }
+	};
+
+}} // ZXing::Utility
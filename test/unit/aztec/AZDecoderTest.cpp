@@ -97,7 +97,7 @@ TEST(AZDecoderTest, DecodeTooManyErrors)
 		, 'X', true);
 
 	DecoderResult result = Aztec::Decoder::Decode({{std::move(bits), {}}, true, 16, 4});
-	EXPECT_EQ(result.errorCode(), DecodeStatus::FormatError);
+	EXPECT_EQ(result.errorCode(), DecodeStatus::ChecksumError);
 }
 
 TEST(AZDecoderTest, DecodeTooManyErrors2)
@@ -133,5 +133,5 @@ TEST(AZDecoderTest, DecodeTooManyErrors2)
 		, 'X', true);
 
 	DecoderResult result = Aztec::Decoder::Decode({{std::move(bits), {}}, true, 16, 4});
-	EXPECT_EQ(result.errorCode(), DecodeStatus::FormatError);
+	EXPECT_EQ(result.errorCode(), DecodeStatus::ChecksumError);
 }
@@ -17,11 +17,22 @@
 
 #include "aztec/AZDetector.h"
 #include "BitMatrixIO.h"
+#include "DecodeHints.h"
+#include "DecoderResult.h"
+#include "PatternRowSample.h"
 #include "PseudoRandom.h"
+#include "Result.h"
+#include "SymbolDrawing.h"
+#include "aztec/AZDecoder.h"
 #include "aztec/AZDetectorResult.h"
+#include "aztec/AZReader.h"
+#include "aztec/AZWriter.h"
 
 #include "gtest/gtest.h"
+#include <set>
+#include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 using namespace ZXing;
@@ -204,3 +215,83 @@ TEST(AZDetectorTest, ErrorInParameterLocatorNotCompact)
 		, 'X', true)
 	);
 }
+
+TEST(AZDetectorTest, Multiple)
+{
+	std::vector<BitMatrix> symbols;
+	std::set<std::wstring> expected;
+	for (int i = 1; i <= 9; ++i) {
+		auto text = L"Aztec " + std::to_wstring(i);
+		symbols.push_back(Aztec::Writer().setMargin(0).encode(text, 0, 0));
+		if (i == 5)
+			symbols.back().mirror();
+		expected.insert(text);
+	}
+
+	for (auto [moduleSize, angle] : {std::pair{2.0, 0.0}, {2.6, 0.0}, {5.0, 5.0}, {5.5, 4.0}, {6.0, -8.0}}) {
+		auto info = testing::Message() << "moduleSize " << moduleSize << ", angle " << angle;
+		for (bool tryHarder : {false, true}) {
+			auto image = Utility::BitMatrixBitmap(
+				Utility::DrawSymbols(symbols, int(240 * moduleSize), int(180 * moduleSize), moduleSize, angle));
+			auto results = Aztec::Detector::DetectMultiple(image, tryHarder);
+			std::set<std::wstring> found;
+			for (auto& candidates : results)
+				for (auto& res : candidates)
+					if (auto decoded = Aztec::Decoder::Decode(res); decoded.isValid())
+						found.insert(decoded.text());
+
+			EXPECT_EQ(results.size(), expected.size()) << info; // every symbol is only reported once
+			EXPECT_EQ(found, expected) << info;
+		}
+	}
+}
+
+TEST(AZDetectorTest, HasBullsEye)
+{
+	auto hasBullsEye = [](BitMatrix&& image) {
+		return Aztec::Detector::HasBullsEye(PatternRowSample(Utility::BitMatrixBitmap(std::move(image))));
+	};
+
+	auto symbol = Aztec::Writer().setMargin(0).encode(L"pre-check", 0, 0);
+	for (auto [moduleSize, angle] : {std::pair{2.0, 0.0}, {2.5, 0.0}, {3.5, 0.0}, {3.0, 25.0}}) {
+		BitMatrix image(200, 200);
+		Utility::DrawSymbol(image, symbol, {100, 100}, moduleSize, angle);
+		EXPECT_TRUE(hasBullsEye(std::move(image))) << "moduleSize " << moduleSize << ", angle " << angle;
+	}
+
+	// the row through the bull's eye alone, i.e. without the matching column, looks like a 1D barcode
+	BitMatrix image(200, 200);
+	Utility::DrawSymbol(image, symbol, {100, 100}, 3);
+	EXPECT_FALSE(hasBullsEye(Utility::RepeatRow(image, 100)));
+}
+
+TEST(AZDetectorTest, MirrorStateFromModeMessage)
+{
+	auto symbol = Aztec::Writer().setMargin(2).encode(L"Mirrored", 0, 0);
+	for (bool isMirror : {false, true}) {
+		BitMatrix copy = symbol.copy();
+		if (isMirror)
+			copy.mirror();
+		auto candidates = Aztec::Detector::Detect(MakeLarger(copy, 3), true);
+		ASSERT_FALSE(candidates.empty());
+		EXPECT_EQ(Aztec::Decoder::Decode(candidates.front()).text(), L"Mirrored");
+	}
+}
+
+TEST(AZDetectorTest, MirrorStateFromData)
+{
+	// damage the mode message ring of a mirrored symbol such that the mode message also passes its parity check when
+	// read in the normal (wrong) mirror state. only decoding the data can tell which one is right.
+	auto symbol = Aztec::Writer().setMargin(0).encode(L"Mirrored", 0, 0);
+	symbol.mirror();
+	for (PointI p : {PointI{5, 2}, {11, 2}, {2, 3}, {5, 12}})
+		symbol.flip(p.x, p.y);
+
+	auto candidates = Aztec::Detector::Detect(MakeLarger(symbol, 3), true);
+	ASSERT_EQ(candidates.size(), 2u);
+	EXPECT_FALSE(Aztec::Decoder::Decode(candidates[0]).isValid());
+	EXPECT_EQ(Aztec::Decoder::Decode(candidates[1]).text(), L"Mirrored");
+
+	auto result = Aztec::Reader(DecodeHints().setIsPure(true)).decode(Utility::BitMatrixBitmap(MakeLarger(symbol, 3)));
+	EXPECT_EQ(result.text(), L"Mirrored");
+}
@@ -0,0 +1,107 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BitMatrix.h"
+#include "DecoderResult.h"
+#include "DetectorResult.h"
+#include "PatternRowSample.h"
+#include "PseudoRandom.h"
+#include "SymbolDrawing.h"
+#include "datamatrix/DMDecoder.h"
+#include "datamatrix/DMDetector.h"
+#include "datamatrix/DMWriter.h"
+
+#include "gtest/gtest.h"
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::DataMatrix;
+
+static std::set<std::wstring> DetectAndDecodeAll(const BinaryBitmap& image, size_t& count)
+{
+	// the single symbol detector only looks through the center of the image
+	auto results = DetectMultiple(image, false, false);
+	std::set<std::wstring> found;
+	for (auto& res : results)
+		found.insert(Decode(res.bits()).text());
+	count = results.size();
+	return found;
+}
+
+TEST(DMDetectorTest, Multiple)
+{
+	std::vector<BitMatrix> symbols;
+	std::set<std::wstring> expected;
+	for (int i = 1; i <= 9; ++i) {
+		auto text = L"DM " + std::to_wstring(i);
+		symbols.push_back(Writer().setMargin(0).encode(text, 0, 0));
+		expected.insert(text);
+	}
+
+	for (auto [moduleSize, angle] : {std::pair{3.0, 0.0}, {2.7, 0.0}, {3.0, 15.0}, {2.6, -33.0}}) {
+		size_t count = 0;
+		Utility::BitMatrixBitmap bitmap(Utility::DrawSymbols(symbols, 480, 360, moduleSize, angle));
+		auto found = DetectAndDecodeAll(bitmap, count);
+		EXPECT_EQ(count, expected.size()) << "moduleSize " << moduleSize << ", angle " << angle; // only reported once
+		EXPECT_EQ(found, expected) << "moduleSize " << moduleSize << ", angle " << angle;
+	}
+}
+
+TEST(DMDetectorTest, RotatedSmallModules)
+{
+	// the legs of symbols with the minimal module size are only a few pixels thick in whichever direction they are
+	// scanned at these angles. they must still pass the quick rejection of the multi symbol scan and of Detect.
+	auto symbol = Writer().setMargin(0).encode(L"small", 0, 0);
+	for (double moduleSize : {2.0, 2.3, 2.5})
+		for (double angle : {-30.0, -26.6, -22.5, 30.0}) {
+			BitMatrix image(160, 160);
+			Utility::DrawSymbol(image, symbol, {80, 80}, moduleSize, angle);
+			Utility::BitMatrixBitmap bitmap(std::move(image));
+			auto info = testing::Message() << "moduleSize " << moduleSize << ", angle " << angle;
+
+			size_t count = 0;
+			EXPECT_EQ(DetectAndDecodeAll(bitmap, count), std::set<std::wstring>{L"small"}) << info;
+
+			auto res = Detect(bitmap, true, true, false);
+			ASSERT_TRUE(res.isValid()) << info;
+			EXPECT_EQ(Decode(res.bits()).text(), L"small") << info;
+		}
+}
+
+TEST(DMDetectorTest, HasFinderPattern)
+{
+	auto symbol = Writer().setMargin(0).encode(L"pre-check", 0, 0);
+	for (double moduleSize : {3.0, 4.5})
+		for (double angle : {0.0, 10.0, -15.0}) {
+			BitMatrix image(200, 200);
+			Utility::DrawSymbol(image, symbol, {100, 100}, moduleSize, angle);
+			Utility::BitMatrixBitmap bitmap(std::move(image));
+			EXPECT_TRUE(HasFinderPattern(PatternRowSample(bitmap))) << "moduleSize " << moduleSize << ", angle " << angle;
+		}
+
+	// isolated black pixels and short runs do not form the corner of an 'L'
+	BitMatrix noise(200, 200);
+	PseudoRandom random(1);
+	for (int y = 0; y < noise.height(); y += 2)
+		for (int x = 0; x < noise.width(); x += 2)
+			if (random.next(0, 1))
+				noise.set(x, y);
+	EXPECT_FALSE(HasFinderPattern(PatternRowSample(Utility::BitMatrixBitmap(std::move(noise)))));
+}
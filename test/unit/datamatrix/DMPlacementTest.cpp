@@ -15,9 +15,11 @@
 * limitations under the License.
 */
 
+#include "BitMatrix.h"
 #include "BitMatrixIO.h"
 #include "ByteArray.h"
 #include "datamatrix/DMBitLayout.h"
+#include "datamatrix/DMWriter.h"
 
 #include "gtest/gtest.h"
 #include <algorithm>
@@ -56,3 +58,19 @@ TEST(DMPlacementTest, Placement)
         "001011001010\n";
     EXPECT_EQ(expected, ToString(matrix, '1', '0', false));
   }
+
+TEST(DMPlacementTest, MirroredRead)
+{
+	for (auto text : {L"AIMAIM", L"a mirrored symbol with more than one data region"}) {
+		auto symbol = Writer().setMargin(0).encode(text, 0, 0);
+		// flip along the anti-diagonal, which keeps the 'L' in place
+		BitMatrix mirrored(symbol.height(), symbol.width());
+		for (int y = 0; y < mirrored.height(); ++y)
+			for (int x = 0; x < mirrored.width(); ++x)
+				mirrored.set(x, y, symbol.get(symbol.width() - 1 - y, symbol.height() - 1 - x));
+
+		auto codewords = CodewordsFromBitMatrix(symbol);
+		ASSERT_FALSE(codewords.empty());
+		EXPECT_EQ(CodewordsFromBitMatrix(mirrored, true), codewords);
+	}
+}
@@ -0,0 +1,196 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BitMatrix.h"
+#include "DetectorResult.h"
+#include "PatternRowSample.h"
+#include "PerspectiveTransform.h"
+#include "PseudoRandom.h"
+#include "SymbolDrawing.h"
+#include "maxicode/MCDetector.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <utility>
+
+using namespace ZXing;
+
+namespace {
+
+	// Geometry of the symbol as described in ISO/IEC 16023 (in units of the module pitch).
+	constexpr int WIDTH = 30;
+	constexpr int HEIGHT = 33;
+	constexpr double ROW_PITCH = 0.8660254037844386;
+	constexpr double RING_WIDTH = 4.55 / 6; // center, 2 light and 3 dark rings
+
+	PointF ModuleCenter(int x, int y) { return {x + 0.5 + (y & 1) * 0.5, (y + 0.5) * ROW_PITCH}; }
+
+	const PointF BULLS_EYE_CENTER = ModuleCenter(14, 16);
+
+	// Modules closer than this to the bull's eye center are not part of the data area.
+	constexpr double BULLS_EYE_AREA = 5.2;
+
+	struct OrientationModule
+	{
+		int x, y;
+		bool black;
+	};
+
+	constexpr OrientationModule ORIENTATION_MODULES[] = {
+		{10, 9, true},   {11, 9, true},   {11, 10, true},  // top left
+		{17, 9, false},  {17, 10, false}, {18, 10, false}, // top right
+		{7, 15, true},   {7, 16, false},  {8, 16, true},   // left
+		{20, 16, true},  {21, 16, false}, {20, 17, true},  // right
+		{10, 22, true},  {11, 22, false}, {10, 23, true},  // bottom left
+		{17, 22, true},  {16, 23, false}, {17, 23, true},  // bottom right
+	};
+
+	// A 30 x 33 grid of random data modules with the orientation modules set and the bull's eye area cleared.
+	BitMatrix MakeSymbol(int seed)
+	{
+		PseudoRandom random(seed);
+		BitMatrix symbol(WIDTH, HEIGHT);
+		for (int y = 0; y < HEIGHT; ++y)
+			for (int x = 0; x < WIDTH; ++x)
+				if (distance(ModuleCenter(x, y), BULLS_EYE_CENTER) > BULLS_EYE_AREA && random.next(0, 1))
+					symbol.set(x, y);
+		for (auto& m : ORIENTATION_MODULES)
+			symbol.set(m.x, m.y, m.black);
+		return symbol;
+	}
+
+	// Renders the hexagonal modules and the bull's eye of symbol into an image of the given size with the
+	// corners of the symbol (tl, tr, br, bl) at position.
+	BitMatrix Render(const BitMatrix& symbol, int width, int height, const QuadrilateralF& position)
+	{
+		QuadrilateralF grid = {PointF{0, 0}, {WIDTH + 0.5, 0}, {WIDTH + 0.5, HEIGHT * ROW_PITCH}, {0, HEIGHT * ROW_PITCH}};
+		PerspectiveTransform pix2Grid(position, grid);
+		BitMatrix image(width, height);
+		for (int py = 0; py < height; ++py)
+			for (int px = 0; px < width; ++px) {
+				auto p = pix2Grid(PointF(px + 0.5, py + 0.5));
+				auto r = distance(p, BULLS_EYE_CENTER);
+				if (r < 6 * RING_WIDTH) {
+					image.set(px, py, int(r / RING_WIDTH) % 2 == 1);
+					continue;
+				}
+				// the modules are the cells of the Voronoi diagram of the module centers, i.e. hexagons
+				int row = static_cast<int>(std::floor(p.y / ROW_PITCH));
+				double best = 1;
+				bool black = false;
+				for (int y = row - 1; y <= row + 1; ++y)
+					for (int x = static_cast<int>(std::floor(p.x)) - 1; x <= static_cast<int>(std::floor(p.x)) + 1; ++x) {
+						if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT)
+							continue;
+						auto d = distance(p, ModuleCenter(x, y));
+						if (d < best) {
+							best = d;
+							black = symbol.get(x, y);
+						}
+					}
+				image.set(px, py, black);
+			}
+		return image;
+	}
+
+	QuadrilateralF Transformed(double moduleSize, PointF center, double angle, double skew)
+	{
+		double cs = std::cos(angle * 3.14159265358979 / 180), sn = std::sin(angle * 3.14159265358979 / 180);
+		QuadrilateralF res;
+		PointF corners[] = {{0, 0}, {WIDTH + 0.5, 0}, {WIDTH + 0.5, HEIGHT * ROW_PITCH}, {0, HEIGHT * ROW_PITCH}};
+		for (int i = 0; i < 4; ++i) {
+			auto c = corners[i] - BULLS_EYE_CENTER;
+			c = {c.x + skew * c.y, c.y};
+			res[i] = center + moduleSize * PointF{cs * c.x - sn * c.y, sn * c.x + cs * c.y};
+		}
+		return res;
+	}
+
+	int CountModuleErrors(const BitMatrix& symbol, const BitMatrix& bits)
+	{
+		int errors = 0;
+		for (int y = 0; y < HEIGHT; ++y)
+			for (int x = 0; x < WIDTH; ++x)
+				if (distance(ModuleCenter(x, y), BULLS_EYE_CENTER) > BULLS_EYE_AREA)
+					errors += symbol.get(x, y) != bits.get(x, y);
+		return errors;
+	}
+
+} // namespace
+
+TEST(MCDetectorTest, Upright)
+{
+	auto symbol = MakeSymbol(1);
+	auto image = Render(symbol, 300, 300, Transformed(7, {150, 150}, 0, 0));
+	auto res = MaxiCode::Detect(Utility::BitMatrixBitmap(std::move(image)), false);
+	ASSERT_EQ(res.size(), 1u);
+	ASSERT_EQ(res[0].bits().width(), WIDTH);
+	ASSERT_EQ(res[0].bits().height(), HEIGHT);
+	EXPECT_EQ(CountModuleErrors(symbol, res[0].bits()), 0);
+}
+
+TEST(MCDetectorTest, RotatedAndSkewed)
+{
+	struct
+	{
+		double moduleSize, angle, skew;
+	} cases[] = {{7, 30, 0}, {6, -100, 0}, {7, 200, 0.1}, {8, 15, -0.15}, {6.5, -60, 0.2}};
+
+	int seed = 2;
+	for (auto [moduleSize, angle, skew] : cases) {
+		auto symbol = MakeSymbol(seed++);
+		auto image = Render(symbol, 360, 360, Transformed(moduleSize, {180, 180}, angle, skew));
+		auto res = MaxiCode::Detect(Utility::BitMatrixBitmap(std::move(image)), false);
+		ASSERT_EQ(res.size(), 1u) << moduleSize << " " << angle << " " << skew;
+		EXPECT_EQ(CountModuleErrors(symbol, res[0].bits()), 0) << moduleSize << " " << angle << " " << skew;
+	}
+}
+
+TEST(MCDetectorTest, RefineGridForPerspective)
+{
+	auto symbol = MakeSymbol(10);
+	auto position = Transformed(7, {180, 180}, 10, 0);
+	// a shorter top edge, as if seen from below
+	auto shift = 0.04 * (position[1] - position[0]);
+	position[0] += shift;
+	position[1] = position[1] - shift;
+	auto image = Render(symbol, 360, 360, position);
+
+	auto res = MaxiCode::Detect(Utility::BitMatrixBitmap(image.copy()), false);
+	ASSERT_EQ(res.size(), 1u);
+	// the affine grid around the bull's eye does not fit the outer modules
+	EXPECT_GT(CountModuleErrors(symbol, res[0].bits()), 0);
+
+	auto refined = MaxiCode::RefineGrid(image, res[0]);
+	ASSERT_TRUE(refined.isValid());
+	EXPECT_EQ(CountModuleErrors(symbol, refined.bits()), 0);
+}
+
+TEST(MCDetectorTest, HasBullsEye)
+{
+	auto symbol = MakeSymbol(11);
+	for (double moduleSize : {3.0, 7.0})
+		for (double angle : {0.0, 35.0}) {
+			auto image = Render(symbol, 360, 360, Transformed(moduleSize, {180, 180}, angle, 0));
+			EXPECT_TRUE(MaxiCode::HasBullsEye(PatternRowSample(Utility::BitMatrixBitmap(std::move(image)))))
+				<< moduleSize << " " << angle;
+		}
+
+	// the row through the bull's eye alone, i.e. without the matching column, looks like a 1D barcode
+	auto image = Render(symbol, 360, 360, Transformed(7, {180, 180}, 0, 0));
+	EXPECT_FALSE(MaxiCode::HasBullsEye(PatternRowSample(Utility::BitMatrixBitmap(Utility::RepeatRow(image, 180)))));
+}
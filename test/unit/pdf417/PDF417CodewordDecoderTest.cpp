@@ -0,0 +1,161 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "PseudoRandom.h"
+#include "pdf417/PDFCodewordDecoder.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+using ModuleBitCount = std::array<int, ZXing::Pdf417::CodewordDecoder::BARS_IN_MODULE>;
+
+namespace ZXing { namespace Pdf417 {
+	int GetClosestDecodedValue(const ModuleBitCount& moduleBitCount);
+}}
+
+using namespace ZXing;
+using namespace ZXing::Pdf417;
+
+namespace {
+
+	constexpr int BARS = CodewordDecoder::BARS_IN_MODULE;
+
+	// All valid symbols in ascending order, i.e. the same order as the table of the decoder.
+	const std::vector<int>& Symbols()
+	{
+		static const std::vector<int> symbols = [] {
+			std::vector<int> res;
+			for (int symbol = 1 << (CodewordDecoder::MODULES_IN_CODEWORD - 1); symbol < (1 << CodewordDecoder::MODULES_IN_CODEWORD);
+				 ++symbol)
+				if (CodewordDecoder::GetCodeword(symbol) != -1)
+					res.push_back(symbol);
+			return res;
+		}();
+		return symbols;
+	}
+
+	ModuleBitCount Widths(int symbol)
+	{
+		ModuleBitCount res = {};
+		for (int i = 0, bit = CodewordDecoder::MODULES_IN_CODEWORD - 1; i < BARS; ++i)
+			for (bool black = i % 2 == 0; bit >= 0 && ((symbol >> bit) & 1) == black; --bit)
+				res[i]++;
+		return res;
+	}
+
+	const std::vector<std::array<float, BARS>>& Ratios()
+	{
+		static const std::vector<std::array<float, BARS>> ratios = [] {
+			std::vector<std::array<float, BARS>> res;
+			for (int symbol : Symbols()) {
+				auto widths = Widths(symbol);
+				std::array<float, BARS> ratio;
+				for (int k = 0; k < BARS; k++)
+					ratio[k] = static_cast<float>(widths[k]) / CodewordDecoder::MODULES_IN_CODEWORD;
+				res.push_back(ratio);
+			}
+			return res;
+		}();
+		return ratios;
+	}
+
+	// The original linear scan over all symbols, computing the error in the same order as the decoder.
+	int LinearScan(const ModuleBitCount& moduleBitCount)
+	{
+		int bitCountSum = 0;
+		for (int c : moduleBitCount)
+			bitCountSum += c;
+		std::array<float, BARS> bitCountRatios = {};
+		if (bitCountSum > 1)
+			for (int i = 0; i < BARS; i++)
+				bitCountRatios[i] = moduleBitCount[i] / (float)bitCountSum;
+
+		float bestMatchError = std::numeric_limits<float>::max();
+		int bestMatch = -1;
+		for (size_t j = 0; j < Symbols().size(); j++) {
+			float error = 0.0f;
+			for (int k = 0; k < BARS; k++) {
+				float diff = Ratios()[j][k] - bitCountRatios[k];
+				error += diff * diff;
+				if (error >= bestMatchError)
+					break;
+			}
+			if (error < bestMatchError) {
+				bestMatchError = error;
+				bestMatch = Symbols()[j];
+			}
+		}
+		return bestMatch;
+	}
+
+} // namespace
+
+TEST(PDF417CodewordDecoderTest, SymbolTable)
+{
+	ASSERT_EQ(Symbols().size(), 2787u);
+	for (int symbol : Symbols())
+		EXPECT_EQ(GetClosestDecodedValue(Widths(symbol)), symbol);
+}
+
+TEST(PDF417CodewordDecoderTest, RandomBitCounts)
+{
+	PseudoRandom random(1);
+	for (int n = 0; n < 20000; ++n) {
+		ModuleBitCount bitCount;
+		for (auto& c : bitCount)
+			c = random.next(0, 12);
+		ASSERT_EQ(GetClosestDecodedValue(bitCount), LinearScan(bitCount)) << n;
+	}
+}
+
+TEST(PDF417CodewordDecoderTest, PerturbedSymbols)
+{
+	PseudoRandom random(2);
+	const auto& symbols = Symbols();
+	for (int n = 0; n < 20000; ++n) {
+		int moduleSize = random.next(1, 5);
+		ModuleBitCount bitCount = Widths(symbols[random.next<size_t>(0, symbols.size() - 1)]);
+		for (auto& c : bitCount)
+			c = std::max(0, c * moduleSize + random.next(-moduleSize, moduleSize));
+		ASSERT_EQ(GetClosestDecodedValue(bitCount), LinearScan(bitCount)) << n;
+	}
+}
+
+TEST(PDF417CodewordDecoderTest, Ties)
+{
+	// the sum of the widths of two symbols is exactly half way between them, the one found first has to win (up to rounding)
+	PseudoRandom random(3);
+	const auto& symbols = Symbols();
+	for (int n = 0; n < 5000; ++n) {
+		auto a = Widths(symbols[random.next<size_t>(0, symbols.size() - 1)]);
+		auto b = Widths(symbols[random.next<size_t>(0, symbols.size() - 1)]);
+		ModuleBitCount bitCount;
+		for (int i = 0; i < BARS; ++i)
+			bitCount[i] = a[i] + b[i];
+		ASSERT_EQ(GetClosestDecodedValue(bitCount), LinearScan(bitCount)) << n;
+	}
+
+	// all widths equal: many symbols have the same error
+	for (int width = 0; width < 4; ++width) {
+		ModuleBitCount bitCount;
+		bitCount.fill(width);
+		EXPECT_EQ(GetClosestDecodedValue(bitCount), LinearScan(bitCount)) << width;
+	}
+}
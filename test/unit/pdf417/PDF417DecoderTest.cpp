@@ -15,9 +15,13 @@
 * limitations under the License.
 */
 
+#include "CharacterSet.h"
 #include "DecodeStatus.h"
+#include "DecoderResult.h"
+#include "pdf417/PDFCompaction.h"
 #include "pdf417/PDFDecodedBitStreamParser.h"
 #include "pdf417/PDFDecoderResultExtra.h"
+#include "pdf417/PDFHighLevelEncoder.h"
 
 #include "gtest/gtest.h"
 
@@ -113,3 +117,15 @@ TEST(PDF417DecoderTest, SampleWithNumericValues)
 	EXPECT_EQ(30, resultMetadata.fileSize());
 	EXPECT_EQ(260013, resultMetadata.checksum());
 }
+
+TEST(PDF417DecoderTest, NumericCompactionRoundTrip)
+{
+	// more than one group of 44 digits, with leading zeros in both of them
+	std::wstring digits = L"0012345678901234567890123456789012345678901234000000000098765432109876543210";
+	auto codewords = HighLevelEncoder::EncodeHighLevel(digits, Compaction::NUMERIC, CharacterSet::ISO8859_1);
+	codewords.insert(codewords.begin(), static_cast<int>(codewords.size()) + 1);
+	codewords.push_back(900); // the decoder expects the (here irrelevant) error correction codewords to follow
+
+	auto result = DecodedBitStreamParser::Decode(codewords, 0);
+	EXPECT_EQ(result.text(), digits);
+}
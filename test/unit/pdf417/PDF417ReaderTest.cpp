@@ -0,0 +1,130 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BitMatrix.h"
+#include "DecodeHints.h"
+#include "DecoderResult.h"
+#include "Result.h"
+#include "SymbolDrawing.h"
+#include "pdf417/PDFDetector.h"
+#include "pdf417/PDFReader.h"
+#include "pdf417/PDFScanningDecoder.h"
+#include "pdf417/PDFWriter.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+namespace ZXing { namespace Pdf417 {
+	DecoderResult DecodeRows(const BitMatrix& image, const std::array<Nullable<ResultPoint>, 8>& points);
+}}
+
+using namespace ZXing;
+using namespace ZXing::Pdf417;
+
+namespace {
+
+	BitMatrix Encode(const std::wstring& text)
+	{
+		return Writer().setMargin(0).encode(text, 1, 1); // rows 4 modules high
+	}
+
+	// Draws the symbol with 3 pixels per module and its rows inclined by shear pixels per pixel.
+	BitMatrix DrawSheared(const BitMatrix& symbol, double shear)
+	{
+		double w = symbol.width() * 3, h = symbol.height() * 3;
+		BitMatrix image(int(w) + 80, int(h + w * shear) + 80);
+		PointF o = {40, 40};
+		Utility::DrawSymbol(image, symbol, {o, o + PointF{w, w * shear}, o + PointF{w, w * shear + h}, o + PointF{0, h}});
+		return image;
+	}
+
+	// Copies symbol into image with its top left corner at (left, top), rotated by 180 degrees if requested.
+	void Paste(BitMatrix& image, const BitMatrix& symbol, int left, int top, bool rotate180 = false)
+	{
+		for (int y = 0; y < symbol.height(); ++y)
+			for (int x = 0; x < symbol.width(); ++x)
+				if (rotate180 ? symbol.get(symbol.width() - 1 - x, symbol.height() - 1 - y) : symbol.get(x, y))
+					image.set(left + x, top + y);
+	}
+
+} // namespace
+
+TEST(PDF417ReaderTest, NextRotationAfterDecodeFailure)
+{
+	auto upright = Writer().setMargin(10).encode(L"Upright", 200, 60);
+	auto upsideDown = Writer().setMargin(10).encode(L"Upside down", 200, 60);
+
+	// keep the start and stop patterns of the upright symbol, but wipe out most of its data columns
+	for (int y = 0; y < upright.height(); ++y)
+		for (int x = upright.width() / 3; x < upright.width() * 2 / 3; ++x)
+			upright.set(x, y, false);
+
+	BitMatrix image(std::max(upright.width(), upsideDown.width()), upright.height() + upsideDown.height());
+	Paste(image, upright, 0, 0);
+	Paste(image, upsideDown, 0, upright.height(), true);
+
+	auto result = Pdf417::Reader(DecodeHints()).decode(Utility::BitMatrixBitmap(std::move(image)));
+	ASSERT_TRUE(result.isValid());
+	EXPECT_EQ(result.text(), L"Upside down");
+	EXPECT_EQ(result.orientation(), 180);
+}
+
+TEST(PDF417ReaderTest, DecodeRowsSkewed)
+{
+	for (double shear : {0.0, 0.1, 0.2, 0.3}) {
+		std::list<Detector::Result> detected;
+		Detector::Detect(Utility::BitMatrixBitmap(DrawSheared(Encode(L"Skewed rows"), shear)), false, false, detected);
+		ASSERT_EQ(detected.size(), 1u) << shear;
+		auto& points = detected.front().points.front();
+		auto result = DecodeRows(*detected.front().bits, points);
+		ASSERT_TRUE(result.isValid()) << shear;
+		EXPECT_EQ(result.text(), L"Skewed rows") << shear;
+	}
+}
+
+TEST(PDF417ReaderTest, SkewedBeyondScanningDecoder)
+{
+	// rows inclined by about 11 degrees: the ScanningDecoder fails, the reader falls back to DecodeRows
+	auto image = DrawSheared(Encode(L"Skewed rows"), 0.2);
+
+	std::list<Detector::Result> detected;
+	Detector::Detect(Utility::BitMatrixBitmap(image.copy()), false, false, detected);
+	ASSERT_EQ(detected.size(), 1u);
+	auto& points = detected.front().points.front();
+	EXPECT_FALSE(ScanningDecoder::Decode(*detected.front().bits, points[4], points[5], points[6], points[7], 1, 100).isValid());
+
+	auto result = Pdf417::Reader(DecodeHints()).decode(Utility::BitMatrixBitmap(std::move(image)));
+	ASSERT_TRUE(result.isValid());
+	EXPECT_EQ(result.text(), L"Skewed rows");
+}
+
+TEST(PDF417ReaderTest, DecodeRowsRightRowIndicator)
+{
+	// replace the left row indicator of every row by the invalid codeword 1,1,1,1,1,1,1,10 (same width and number of
+	// edges), so the dimensions and the error correction level can only be read from the right row indicator
+	auto symbol = Encode(L"Right row indicator");
+	for (int y = 0; y < symbol.height(); ++y)
+		for (int x = 17; x < 34; ++x)
+			symbol.set(x, y, x < 24 && (x - 17) % 2 == 0);
+
+	std::list<Detector::Result> detected;
+	Detector::Detect(Utility::BitMatrixBitmap(DrawSheared(symbol, 0.1)), false, false, detected);
+	ASSERT_EQ(detected.size(), 1u);
+	auto result = DecodeRows(*detected.front().bits, detected.front().points.front());
+	ASSERT_TRUE(result.isValid());
+	EXPECT_EQ(result.text(), L"Right row indicator");
+}
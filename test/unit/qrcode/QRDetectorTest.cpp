@@ -0,0 +1,163 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BitMatrix.h"
+#include "ConcentricFinder.h"
+#include "DecodeHints.h"
+#include "DecoderResult.h"
+#include "DetectorResult.h"
+#include "PatternRowSample.h"
+#include "Result.h"
+#include "SymbolDrawing.h"
+#include "ThresholdBinarizer.h"
+#include "qrcode/QRDecoder.h"
+#include "qrcode/QRDetector.h"
+#include "qrcode/QRReader.h"
+#include "qrcode/QRSymbolCache.h"
+#include "qrcode/QRWriter.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+using namespace ZXing;
+using namespace ZXing::QRCode;
+
+namespace {
+
+	// Renders the symbol with the given module size into a 300x300 frame, centered at center and rotated by angle
+	BitMatrix MakeFrame(const BitMatrix& symbol, double moduleSize, PointF center, double angle = 0)
+	{
+		BitMatrix frame(300, 300);
+		Utility::DrawSymbol(frame, symbol, center, moduleSize, angle);
+		return frame;
+	}
+
+}
+
+TEST(QRDetectorTest, Tracking)
+{
+	auto symbol = Writer().setMargin(0).encode(L"tracking test", 0, 0);
+	std::vector<ConcentricPattern> finderPatterns;
+
+	auto res = DetectTracked(Utility::BitMatrixBitmap(MakeFrame(symbol, 4, {110, 100})), false, finderPatterns);
+	ASSERT_TRUE(res.isValid());
+	EXPECT_EQ(Decode(res.bits(), "").text(), L"tracking test");
+	ASSERT_EQ(finderPatterns.size(), 3u);
+	auto tl = finderPatterns[0];
+
+	// symbol moved by a few pixels -> found again around the previous finder pattern positions
+	res = DetectTracked(Utility::BitMatrixBitmap(MakeFrame(symbol, 4, {116, 97})), false, finderPatterns);
+	ASSERT_TRUE(res.isValid());
+	EXPECT_EQ(Decode(res.bits(), "").text(), L"tracking test");
+	ASSERT_EQ(finderPatterns.size(), 3u);
+	EXPECT_NEAR(finderPatterns[0].x - tl.x, 6, 1);
+	EXPECT_NEAR(finderPatterns[0].y - tl.y, -3, 1);
+
+	// symbol slightly rotated and scaled to a non-integer module size -> still found by the tracker
+	res = DetectTracked(Utility::BitMatrixBitmap(MakeFrame(symbol, 3.7, {118, 99}, 6)), false, finderPatterns);
+	ASSERT_TRUE(res.isValid());
+	EXPECT_EQ(Decode(res.bits(), "").text(), L"tracking test");
+	ASSERT_EQ(finderPatterns.size(), 3u);
+
+	// symbol moved far away -> fall back to full scan
+	res = DetectTracked(Utility::BitMatrixBitmap(MakeFrame(symbol, 4, {200, 210})), false, finderPatterns);
+	ASSERT_TRUE(res.isValid());
+	EXPECT_EQ(Decode(res.bits(), "").text(), L"tracking test");
+
+	// symbol lost
+	res = DetectTracked(Utility::BitMatrixBitmap(BitMatrix(300, 300)), false, finderPatterns);
+	EXPECT_FALSE(res.isValid());
+	EXPECT_TRUE(finderPatterns.empty());
+}
+
+TEST(QRDetectorTest, TrackingReader)
+{
+	auto symbol = Writer().setMargin(0).encode(L"tracking test", 0, 0);
+	QRCode::Reader reader(DecodeHints().setTrackSymbols(true));
+	auto read = [&reader](const BitMatrix& frame) {
+		auto lum = ToMatrix<uint8_t>(frame, 0, 255);
+		return reader.decode(ThresholdBinarizer(ImageView(lum.data(), lum.width(), lum.height(), ImageFormat::Lum), 127))
+			.text();
+	};
+
+	EXPECT_EQ(read(MakeFrame(symbol, 4, {110, 100})), L"tracking test");
+
+	// the version and format information of the symbol is cached for the next frame
+	ASSERT_TRUE(reader.symbolCache());
+	int dim = symbol.height();
+	QuadrilateralI pos{PointI{110 - 2 * dim, 100 - 2 * dim}, {110 + 2 * dim, 100 - 2 * dim},
+					   {110 + 2 * dim, 100 + 2 * dim}, {110 - 2 * dim, 100 + 2 * dim}};
+	EXPECT_TRUE(reader.symbolCache()->find(pos, dim));
+
+	EXPECT_EQ(read(MakeFrame(symbol, 3.7, {118, 99}, 6)), L"tracking test");
+	EXPECT_EQ(read(BitMatrix(300, 300)), L"");
+	EXPECT_EQ(read(MakeFrame(symbol, 4, {200, 210})), L"tracking test");
+}
+
+TEST(QRDetectorTest, HasFinderPattern)
+{
+	auto hasFinderPattern = [](BitMatrix&& image) {
+		return HasFinderPattern(PatternRowSample(Utility::BitMatrixBitmap(std::move(image))));
+	};
+
+	auto symbol = Writer().setMargin(0).encode(L"pre-check", 0, 0);
+	for (auto [moduleSize, angle] : {std::pair{1.0, 0.0}, {2.0, 0.0}, {3.5, 0.0}, {3.0, 25.0}})
+		EXPECT_TRUE(hasFinderPattern(MakeFrame(symbol, moduleSize, {150, 150}, angle)))
+			<< "moduleSize " << moduleSize << ", angle " << angle;
+
+	// the row through the top finder patterns alone, i.e. without the matching columns, looks like a 1D barcode
+	int top = 150 - 3 * symbol.height() / 2;
+	EXPECT_FALSE(hasFinderPattern(Utility::RepeatRow(MakeFrame(symbol, 3, {150, 150}), top + 3 * 3 + 1)));
+}
+
+TEST(QRDetectorTest, PureIntegerScale)
+{
+	auto symbol = Writer().setMargin(0).encode(L"integer scale", 0, 0);
+	const int dim = symbol.height();
+	constexpr int QUIET_ZONE = 4; // modules
+
+	// renders the symbol with a quiet zone, its top left corner at QUIET_ZONE * moduleSize
+	auto render = [&](double moduleSize) {
+		int size = int(std::ceil((dim + 2 * QUIET_ZONE) * moduleSize));
+		BitMatrix image(size, size);
+		Utility::DrawSymbol(image, symbol, ((QUIET_ZONE + dim / 2.0) * moduleSize) * PointF(1, 1), moduleSize);
+		return image;
+	};
+
+	for (int moduleSize : {1, 2, 3, 5}) {
+		auto image = render(moduleSize);
+
+		// the integer stride sampling in Deflate gives the same result as sampling at the PointF module centers
+		float offset = QUIET_ZONE * moduleSize + moduleSize / 2.f;
+		auto deflated = Deflate(image, dim, dim, offset, offset, float(moduleSize));
+		BitMatrix expected(dim, dim);
+		for (int y = 0; y < dim; ++y)
+			for (int x = 0; x < dim; ++x)
+				if (image.get(PointF(offset + x * moduleSize, offset + y * moduleSize)))
+					expected.set(x, y);
+		EXPECT_EQ(deflated, expected) << "moduleSize " << moduleSize;
+		EXPECT_EQ(deflated, symbol) << "moduleSize " << moduleSize;
+
+		// the dimension from the top edge of the finder pattern agrees with the one from the timing pattern, which
+		// is used for non-integer module sizes
+		for (double scale : {double(moduleSize), moduleSize + 0.5}) {
+			auto res = Detect(Utility::BitMatrixBitmap(render(scale)), false, true);
+			ASSERT_TRUE(res.isValid()) << "moduleSize " << scale;
+			EXPECT_EQ(res.bits(), symbol) << "moduleSize " << scale;
+		}
+	}
+}
@@ -47,6 +47,13 @@ TEST(QRFormatInformationTest, DecodeWithBitDifference)
 	EXPECT_TRUE(!FormatInformation::DecodeFormatInformation(MASKED_TEST_FORMAT_INFO ^ 0x0F, MASKED_TEST_FORMAT_INFO ^ 0x0F).isValid());
 }
 
+TEST(QRFormatInformationTest, HammingDistance)
+{
+	EXPECT_EQ(0, FormatInformation::DecodeFormatInformation(MASKED_TEST_FORMAT_INFO, MASKED_TEST_FORMAT_INFO).hammingDistance());
+	EXPECT_EQ(1, FormatInformation::DecodeFormatInformation(MASKED_TEST_FORMAT_INFO ^ 0x01, MASKED_TEST_FORMAT_INFO ^ 0x03).hammingDistance());
+	EXPECT_EQ(3, FormatInformation::DecodeFormatInformation(MASKED_TEST_FORMAT_INFO ^ 0x07, MASKED_TEST_FORMAT_INFO ^ 0x07).hammingDistance());
+}
+
 TEST(QRFormatInformationTest, DecodeWithMisread)
 {
     FormatInformation expected = FormatInformation::DecodeFormatInformation(MASKED_TEST_FORMAT_INFO, MASKED_TEST_FORMAT_INFO);
@@ -0,0 +1,60 @@
+/*
+* Copyright 2021 Axel Waggershauser
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "BitMatrix.h"
+#include "DecoderResult.h"
+#include "qrcode/QRDecoder.h"
+#include "qrcode/QRSymbolCache.h"
+#include "qrcode/QRVersion.h"
+#include "qrcode/QRWriter.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+using namespace ZXing::QRCode;
+
+TEST(QRSymbolCacheTest, DecodeWithCache)
+{
+	auto bits = Writer().setMargin(0).setVersion(7).encode(L"cached", 0, 0);
+	int dim = bits.height();
+	SymbolCache cache;
+	QuadrilateralI pos{PointI{100, 100}, {100 + 4 * dim, 100}, {100 + 4 * dim, 100 + 4 * dim}, {100, 100 + 4 * dim}};
+	QuadrilateralI moved{PointI{103, 98}, {103 + 4 * dim, 98}, {103 + 4 * dim, 98 + 4 * dim}, {103, 98 + 4 * dim}};
+
+	EXPECT_FALSE(cache.find(pos, dim));
+	EXPECT_EQ(Decode(bits, "", cache, pos).text(), L"cached");
+
+	auto entry = cache.find(moved, dim);
+	ASSERT_TRUE(entry);
+	EXPECT_EQ(entry->version->versionNumber(), 7);
+	EXPECT_FALSE(entry->mirrored);
+	EXPECT_TRUE(entry->functionPattern);
+
+	// cache hit
+	EXPECT_EQ(Decode(bits, "", cache, moved).text(), L"cached");
+
+	// different size or far away position -> no match
+	EXPECT_FALSE(cache.find(pos, dim + 4));
+	EXPECT_FALSE(cache.find({PointI{300, 300}, {300 + 4 * dim, 300}, {300 + 4 * dim, 300 + 4 * dim}, {300, 300 + 4 * dim}}, dim));
+
+	// a mirrored symbol at the same position fails the verification but is decoded and cached anyway
+	bits.mirror();
+	EXPECT_EQ(Decode(bits, "", cache, pos).text(), L"cached");
+	entry = cache.find(pos, dim);
+	ASSERT_TRUE(entry);
+	EXPECT_TRUE(entry->mirrored);
+	EXPECT_EQ(Decode(bits, "", cache, pos).text(), L"cached");
+}